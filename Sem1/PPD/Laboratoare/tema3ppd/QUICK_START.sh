@@ -22,13 +22,38 @@ echo "  3 - Variant 3: Asynchronous"
 echo "  4 - Variant 1.1: Optimized"
 echo "  5 - Run ALL + verification"
 echo "  6 - Verification only"
+echo "  7 - Variant 4: Carry-lookahead (MPI_Exscan)"
+echo "  8 - Variant 5: Parallel MPI-IO"
+echo "  9 - Variant 2.1: Scatterv/Gatherv (no padding)"
+echo " 10 - Variant 6: Hybrid MPI + threads (--threads T)"
+echo " 11 - Subtraction"
+echo " 12 - Comparison"
+echo " 13 - Multiplication"
+echo " 14 - Sum of many operands (--operands list)"
+echo " 15 - Variant 7: One-sided carry (MPI RMA)"
+echo " 16 - Variant 8: Non-blocking collectives (MPI_Iscatterv/MPI_Igatherv)"
+echo " 17 - Variant 9: Dynamic load balancing (work queue)"
 echo ""
 echo "OUTPUT FILES:"
-echo "  result.txt          - Sequential (reference)"
+echo "  result.bin          - Sequential (reference, binary)"
 echo "  result1.txt         - Variant 1"
 echo "  resultScatter.txt   - Variant 2"
 echo "  resultAsync.txt     - Variant 3"
 echo "  resultOptimized.txt - Variant 1.1"
+echo "  resultLookahead.txt - Variant 4"
+echo "  resultParallelIO.txt - Variant 5"
+echo "  resultScatterv.txt  - Variant 2.1"
+echo "  resultHybrid.txt    - Variant 6"
+echo "  resultRma.txt       - Variant 7"
+echo "  resultNonblocking.txt - Variant 8"
+echo "  resultWorkQueue.txt - Variant 9"
+echo "  resultSubtract.txt, resultCompare.txt, resultMultiply.txt, resultReduce.txt - operations 11-14"
+echo "                        (references: resultSubtractSeq.txt, ...)"
+echo ""
+echo "SERVER MODE (start-up paid once, one job per request):"
+echo "  mpirun -np 4 ./Tema_3 --serve /tmp/tema3.sock &"
+echo "  ./Tema_3 --request /tmp/tema3.sock \"9 100000 100000\""
+echo "  ./Tema_3 --request /tmp/tema3.sock quit"
 echo ""
 echo "EXAMPLES:"
 echo "  # Run Variant 1 with 100 digits, 5 processes"
@@ -40,6 +65,16 @@ echo ""
 echo "  # Run Scatter/Gather with 4 processes"
 echo "  mpirun --oversubscribe -np 4 ./Tema_3 16 16 2"
 echo ""
+echo "  # Other operands: same digits for any number of processes"
+echo "  mpirun --oversubscribe -np 3 ./Tema_3 1000 1000 1 --seed 42"
+echo ""
+echo "  # Worst-case carries: nines, alternating, boundary, block-nines"
+echo "  mpirun --oversubscribe -np 5 ./Tema_3 100000 100000 5 --profile nines --benchmark 3"
+echo ""
+echo "  # Convert a binary number file to text (and back)"
+echo "  ./Tema_3 --to-text firstNumber.bin firstNumber.txt"
+echo "  ./Tema_3 --to-binary firstNumber.txt firstNumber.bin"
+echo ""
 echo "  # Verify existing results"
 echo "  mpirun -np 2 ./Tema_3 100 100 6"
 echo ""
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Scaling benchmark for MPI Large Number Addition
+# Every (N, P) pair is one mpirun; all rows are appended to the same report.
+#
+# Environment (all optional):
+#   SIZES       digits per number      (default "1000 100000 10000000")
+#   PROCS       process counts         (default "2 4 8")
+#   VARIANT     menu choice, 5 = all   (default 5)
+#   PROFILES    carry profiles         (default random)
+#   REPS        timed repetitions      (default 5)
+#   WARMUP      untimed warm-up runs   (default 1)
+#   REPORT      .csv or .json report   (default benchmark.csv)
+
+SIZES=${SIZES:-"1000 100000 10000000"}
+PROCS=${PROCS:-"2 4 8"}
+VARIANT=${VARIANT:-5}
+PROFILES=${PROFILES:-random}
+REPS=${REPS:-5}
+WARMUP=${WARMUP:-1}
+REPORT=${REPORT:-benchmark.csv}
+
+if [ ! -f "./Tema_3" ]; then
+    echo "Building project..."
+    make || exit 1
+fi
+
+rm -f "$REPORT"
+for N in $SIZES; do
+    for P in $PROCS; do
+        for PROFILE in $PROFILES; do
+            echo "N=$N, Processes=$P, Profile=$PROFILE"
+            mpirun --oversubscribe -np $P ./Tema_3 $N $N $VARIANT --profile $PROFILE \
+                --benchmark $REPS --warmup $WARMUP --report "$REPORT" "$@" > /dev/null
+            if [ $? -ne 0 ]; then
+                echo "✗ Run failed"
+            fi
+        done
+    done
+done
+
+echo "Report: $REPORT"
@@ -9,17 +9,25 @@
 class AsyncCalculation {
 private:
     int P;
-    int N_Max;
+    long long N_Max;
+    int chunkSize;
+    bool masterWorks;
 public:
-    AsyncCalculation(const int P, const int N_Max) {
+    // limbs per streamed message and number of chunk buffers in flight per worker
+    static const int DEFAULT_CHUNK_SIZE = 16384;
+    static const int PIPELINE_DEPTH = 4;
+
+    // masterWorks: process 0 also adds the first block instead of only coordinating
+    AsyncCalculation(const int P, const long long N_Max, const bool masterWorks = false,
+                     const int chunkSize = DEFAULT_CHUNK_SIZE) {
         this->P = P;
         this->N_Max = N_Max;
+        this->masterWorks = masterWorks;
+        this->chunkSize = chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE;
     }
     void run();
     void calculator(int rank);
-    int sum(const int *firstNumber, const int *secondNumber, int *result, int size);
-    void passCarry(int* number,int size,int &carry);
 };
 
 
-#endif //TEMA_3_ASYNCCALCULATION_H
\ No newline at end of file
+#endif //TEMA_3_ASYNCCALCULATION_H
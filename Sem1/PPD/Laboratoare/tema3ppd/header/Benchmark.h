@@ -0,0 +1,57 @@
+//
+// Benchmark mode - per phase MPI_Wtime timings of the variants
+// Phase times are the maximum over the processes, reports are CSV or JSON lines
+//
+
+#ifndef TEMA_3_BENCHMARK_H
+#define TEMA_3_BENCHMARK_H
+
+#include <functional>
+#include <string>
+using namespace std;
+
+class Benchmark {
+public:
+    enum Phase { READ, DISTRIBUTE, COMPUTE, CARRY, GATHER, WRITE, PHASES };
+    static const char *PHASE_NAMES[PHASES];
+
+    struct Measurement {
+        string variant;
+        int processes = 0;
+        long long digits = 0;
+        // carry profile of the operands (GenerateNumber::Profile)
+        string profile = "random";
+        int repetitions = 0;
+        double mean = 0, min = 0, max = 0, stddev = 0;
+        double phases[PHASES] = {};
+        double speedup = 0, efficiency = 0;
+        // BufferPool allocations during the timed runs, all processes
+        long long allocations = 0;
+        // non-blocking communication per process: time in flight and the part of it spent
+        // computing instead of waiting (0 for the blocking variants)
+        double inFlight = 0, hidden = 0;
+    };
+
+    // restarts the lap clock of this process
+    static void start();
+    // the time since the previous lap is added to phase
+    static void lap(Phase phase);
+    // records non-blocking communication that was in flight for inFlight seconds, waited seconds
+    // of which were spent blocked in MPI_Wait
+    static void overlap(double inFlight, double waited);
+    // true inside measure, the variants leave the reporting to it
+    static bool measuring();
+
+    // collective: warmup untimed runs, then repetitions timed runs between barriers;
+    // the statistics are only complete on rank 0
+    static Measurement measure(const string &variant, int P, long long N_Max, int warmup, int repetitions,
+                               const function<void()> &calculation);
+    // speedup and efficiency of measurement against the sequential mean
+    static void compare(Measurement &measurement, double sequentialMean);
+    // appends to reportFile, JSON lines if it ends in ".json", CSV otherwise
+    static void report(const string &reportFile, const Measurement &measurement);
+    static void print(const Measurement &measurement);
+};
+
+
+#endif //TEMA_3_BENCHMARK_H
@@ -0,0 +1,115 @@
+//
+// Large number stored as base 10^9 limbs, least significant limb first
+//
+
+#ifndef TEMA_3_BIGNUMBER_H
+#define TEMA_3_BIGNUMBER_H
+
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <mpi.h>
+using namespace std;
+
+// MPI datatype matching BigNumber::Limb
+#define MPI_LIMB MPI_UINT32_T
+
+class BigNumber {
+public:
+    typedef uint32_t Limb;
+    static const Limb BASE = 1000000000;
+    static const int DIGITS_PER_LIMB = 9;
+    // below this many limbs multiply uses the schoolbook product instead of Karatsuba
+    static const int KARATSUBA_THRESHOLD = 32;
+
+private:
+    vector<Limb> limbs;
+    long long numberOfDigits;
+
+public:
+    explicit BigNumber(long long numberOfDigits = 0)
+        : limbs(limbCount(numberOfDigits), 0),
+          numberOfDigits(numberOfDigits) {
+    }
+
+    // digit counts and limb offsets are 64-bit, numbers may exceed 2^31 digits
+    static long long limbCount(long long numberOfDigits) {
+        return (numberOfDigits + DIGITS_PER_LIMB - 1) / DIGITS_PER_LIMB;
+    }
+
+    // the parallel variants use int MPI counts and displacements: at most INT_MAX limbs in total
+    // and INT_MAX / 2 digits ("d " text layout) per process
+    static bool fitsParallel(long long numberOfDigits, int processes) {
+        const long long limbs = limbCount(numberOfDigits);
+        const long long processDigits = (limbs / (processes > 1 ? processes - 1 : 1) + 1) * DIGITS_PER_LIMB;
+        return limbs <= INT_MAX - processes && processDigits <= INT_MAX / 2;
+    }
+
+    long long getNumberOfDigits() const { return numberOfDigits; }
+    long long getSize() const { return (long long) limbs.size(); }
+    Limb *data() { return limbs.data(); }
+    const Limb *data() const { return limbs.data(); }
+    int digit(long long index) const;
+    // keeps the lowest numberOfDigits digits' limbs, new limbs are 0
+    void resize(long long numberOfDigits);
+
+    // result = first + second + carry over size limbs, returns the outgoing carry (0 or 1);
+    // runs the AVX2/SSE2/scalar kernel picked at startup for this CPU
+    static Limb sum(const Limb *first, const Limb *second, Limb *result, long long size, Limb carry = 0);
+    static const char *sumKernelName();
+    // same for operands shorter than the result, their missing limbs count as 0
+    static Limb sum(const Limb *first, long long firstSize, const Limb *second, long long secondSize,
+                    Limb *result, long long size);
+    // adds an incoming carry to an already computed block, stops once it is absorbed
+    static void passCarry(Limb *number, long long size, Limb &carry);
+    // number of BASE - 1 limbs at the bottom of a computed block: an incoming carry
+    // turns exactly these limbs into 0 and increments the next one
+    static long long carryRun(const Limb *number, long long size);
+    // applies an incoming carry of 1 in O(run), run == carryRun(number, size)
+    static void selectCarry(Limb *number, long long size, long long run);
+
+    // result = first - second - borrow over size limbs, returns the outgoing borrow (0 or 1)
+    static Limb subtract(const Limb *first, const Limb *second, Limb *result, long long size, Limb borrow = 0);
+    // takes an incoming borrow out of an already computed block, stops once it is absorbed
+    static void passBorrow(Limb *number, long long size, Limb &borrow);
+    // number of 0 limbs at the bottom of a block: a borrow turns them into BASE - 1
+    static long long borrowRun(const Limb *number, long long size);
+    static void selectBorrow(Limb *number, long long size, long long run);
+
+    // index of the most significant limb where the operands differ (-1 if equal),
+    // order is -1, 0 or 1 as first <, == or > second
+    static long long topDifference(const Limb *first, const Limb *second, long long size, int &order);
+    static int compare(const Limb *first, const Limb *second, long long size);
+    // result (firstSize + secondSize limbs) = first * second: schoolbook for short operands,
+    // Karatsuba over pieces of the shorter operand's size otherwise
+    static void multiply(const Limb *first, long long firstSize, const Limb *second, long long secondSize,
+                         Limb *result);
+
+    // carry-save accumulator word, one per limb: the limbs of up to 2^64 / BASE operands are
+    // added without carries and normalized once at the end
+    typedef uint64_t Accumulator;
+    static void accumulate(Accumulator *accumulator, const Limb *number, long long size);
+    // accumulator -> size limbs, returns what is left over the top limb
+    static Accumulator normalize(const Accumulator *accumulator, long long size, Limb *result);
+
+    // packs count decimal digits (LSD first) into size limbs, zero padding the rest
+    static void packDigits(const uint8_t *digits, long long count, Limb *number, long long size);
+    static void unpackDigits(const Limb *number, long long count, uint8_t *digits);
+
+    // writes the first numberOfDigits digits of the block in the "d d d " text layout,
+    // formatted in chunks of WRITE_CHUNK_DIGITS with one out.write per chunk
+    static const int WRITE_CHUNK_DIGITS = 2048 * DIGITS_PER_LIMB;
+    static void writeDigits(ostream &out, const Limb *number, long long size, long long numberOfDigits);
+    // same layout into a buffer, every digit takes exactly 2 bytes; returns the bytes written
+    static long long formatDigits(const Limb *number, long long size, long long numberOfDigits, char *buffer);
+    // reverse of formatDigits: every character of text that is not whitespace becomes c - '0'
+    // (0-9 for digits); returns the number of values, at most length
+    static long long parseDigits(const char *text, long long length, uint8_t *digits);
+    // decimal digit at position numberOfDigits of a sum whose operands have at most
+    // numberOfDigits digits; topLimb holds digit numberOfDigits - 1
+    static Limb overflowDigit(Limb topLimb, long long numberOfDigits, Limb carry);
+};
+
+
+#endif //TEMA_3_BIGNUMBER_H
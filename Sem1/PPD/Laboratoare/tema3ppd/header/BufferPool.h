@@ -0,0 +1,31 @@
+//
+// Buffer pool - scratch buffers of the calculators, allocated with MPI_Alloc_mem (registered memory
+// where the network supports it) and kept for the next run instead of being freed
+//
+
+#ifndef TEMA_3_BUFFERPOOL_H
+#define TEMA_3_BUFFERPOOL_H
+
+#include <cstddef>
+
+class BufferPool {
+public:
+    // smallest free buffer of at least count elements, a new one only if none fits;
+    // main thread only, MPI must be initialized
+    template<typename T>
+    static T *acquire(long long count) {
+        return static_cast<T *>(acquireBytes((size_t) (count > 0 ? count : 1) * sizeof(T)));
+    }
+    // gives a buffer back to the pool, nullptr is ignored
+    static void release(void *buffer);
+    // frees every buffer, before MPI_Finalize
+    static void clear();
+    // MPI_Alloc_mem calls so far, stays constant once the pool is warm
+    static long long allocations();
+
+private:
+    static void *acquireBytes(size_t bytes);
+};
+
+
+#endif //TEMA_3_BUFFERPOOL_H
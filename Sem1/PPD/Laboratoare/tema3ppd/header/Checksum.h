@@ -0,0 +1,37 @@
+//
+// Checksum mode - hash of a result computed by the processes while they still hold its blocks,
+// so a result can be verified without reading it back
+// hash(number) = sum(limb[i] * R^i) mod 2^61 - 1: blocks hash on their own and the parts add up,
+// and the hash only depends on the value, not on how it was split
+//
+
+#ifndef TEMA_3_CHECKSUM_H
+#define TEMA_3_CHECKSUM_H
+
+#include <cstdint>
+#include <string>
+#include <mpi.h>
+#include "BigNumber.h"
+using namespace std;
+
+class Checksum {
+public:
+    // --checksum: the addition variants write "<result file>.sum" next to their result
+    static bool enabled;
+
+    // part of the hash of the limbs block[0 .. size), which start at limb start of the number
+    static uint64_t hash(const BigNumber::Limb *block, long long size, long long start);
+    static uint64_t add(uint64_t first, uint64_t second);
+    // collective: every process of comm adds the hash of its final block (plus the carry out of the
+    // number on the process where top is true), rank 0 writes the sidecar
+    static void reduce(const string &resultFile, const BigNumber::Limb *block, long long size, long long start,
+                       BigNumber::Limb carry, bool top, MPI_Comm comm);
+    static void write(const string &resultFile, uint64_t hash);
+    // false if resultFile has no sidecar
+    static bool read(const string &resultFile, uint64_t &hash);
+    // drops the sidecar before resultFile is written again, so an old hash never outlives its result
+    static void remove(const string &resultFile);
+};
+
+
+#endif //TEMA_3_CHECKSUM_H
@@ -0,0 +1,29 @@
+//
+// Comparison - Scatterv blocks, one MPI_Allreduce (MPI_MAXLOC) finds the most significant differing limb
+//
+
+#ifndef TEMA_3_COMPARISONCALCULATION_H
+#define TEMA_3_COMPARISONCALCULATION_H
+
+#include <mpi.h>
+#include "BigNumber.h"
+
+class ComparisonCalculation {
+private:
+    int P;
+    long long N_Max;
+public:
+    ComparisonCalculation(const int P, const long long N_Max) {
+        this->P = P;
+        this->N_Max = N_Max;
+    }
+    void run();
+    void calculator(int rank);
+    // -1, 0 or 1 as first <, == or > second, every rank of comm holds the blocks of size limbs
+    // starting at limb blockStart, blocks are ordered by rank
+    static int globalOrder(const BigNumber::Limb *first, const BigNumber::Limb *second, int size, int blockStart,
+                           MPI_Comm comm);
+};
+
+
+#endif //TEMA_3_COMPARISONCALCULATION_H
@@ -1,15 +1,71 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include "BigNumber.h"
 using namespace std;
+
+// Binary number file: this header followed by one byte per decimal digit,
+// least significant digit first (same digit order as the text format).
+struct NumberFileHeader {
+	char magic[4];
+	uint32_t version;
+	uint64_t numberOfDigits;
+};
+
 class GenerateNumber {
 public :
-	static void generateNumber(const string &fileName, int numberOfDigits);
+	static const uint64_t DEFAULT_SEED = 1;
+	// carry profiles of the operands: random digits almost never carry far, the others build the
+	// worst cases of passCarry. Blocks follow the limb split of the parallel variants
+	enum Profile {
+		RANDOM,      // uniform digits
+		NINES,       // 99...9 + 10...01: one carry chain over the whole number
+		ALTERNATING, // runs of 9s, each fed by a carry, between runs of random digits
+		BOUNDARY,    // every block ends with a carry that ripples into the next block
+		BLOCK_NINES  // every other block is a run of 9s fed by a carry from the block before
+	};
+	struct Options {
+		uint64_t seed = DEFAULT_SEED;
+		Profile profile = RANDOM;
+		// blocks of the split (the workers of the variants), used by BOUNDARY and BLOCK_NINES
+		int blocks = 1;
+	};
+	// false for an unknown name
+	static bool parseProfile(const string &name, Profile &profile);
+	static const char *profileName(Profile profile);
+
+	// collective on comm: every process generates whole blocks of digits and writes them straight
+	// to its region of the file. Digits come from counter-based streams keyed by (seed, block),
+	// so the file only depends on seed and numberOfDigits, not on the number of processes
+	static void generateNumber(const string &fileName, long long numberOfDigits, uint64_t seed = DEFAULT_SEED,
+	                           MPI_Comm comm = MPI_COMM_SELF);
+	// collective on comm: firstNumber.bin and secondNumber.bin with the given profile,
+	// random digits from the seeds 2 * seed and 2 * seed + 1
+	static void generateOperands(long long N1, long long N2, const Options &options, MPI_Comm comm);
+
+	static BigNumber readNumber(const string& fileName);
+
+	static void writeNumber(const string &fileName, const BigNumber &number);
+	// header of a binary number file, the digits are expected to follow
+	static void writeHeader(ostream &out, long long numberOfDigits);
 
-	static int* readNumber(const string& fileName);
+	// offset and size are in limbs, digits past the end of the number read as 0
+	static BigNumber::Limb* readNumberBlock(const string& fileName,long long offset,int size);
+	static void readNumberBlock(const string& fileName,long long offset,int size,BigNumber::Limb* table);
+	// collective MPI-IO read, every rank of comm reads its own slice straight from the file
+	static void readNumberBlockAll(MPI_Comm comm, const string& fileName,long long offset,int size,BigNumber::Limb* table);
+	// at least totalSize limbs, zero padded; numberSize receives the limbs of the number itself.
+	// Buffers returned by readNumberP and readNumberBlock belong to BufferPool
+	static BigNumber::Limb* readNumberP(const string &fileName,int totalSize,int *numberSize = nullptr);
+	// -1 if the file is missing or not in the binary format
+	static long long readNumberOfDigits(const string &fileName);
 
-	static void writeNumber(const string &fileName, int* number,int numberOfDigits);
+	// whole file with one read, false if it could not be opened
+	static bool readText(const string &fileName, string &text);
 
-	static int* readNumberBlock(const string& fileName,int offset,int size);
-	static int* readNumberP(const string &fileName,int N_Max);
-};
\ No newline at end of file
+	// Converters between the binary format and the "count\n d d d ..." text format,
+	// false (with a message) on unreadable files, non-digit characters or a wrong digit count
+	static bool convertTextToBinary(const string &textFile, const string &binaryFile);
+	static bool convertBinaryToText(const string &binaryFile, const string &textFile);
+};
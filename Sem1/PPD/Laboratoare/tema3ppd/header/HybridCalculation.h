@@ -0,0 +1,33 @@
+//
+// Variant 6 - Hybrid MPI + threads
+// One rank per node/socket, a std::thread team adds the rank's block.
+// With a Topology the blocks follow the nodes and move through the node leaders
+//
+
+#ifndef TEMA_3_HYBRIDCALCULATION_H
+#define TEMA_3_HYBRIDCALCULATION_H
+
+#include "Topology.h"
+
+class HybridCalculation {
+private:
+    int P;
+    long long N_Max;
+    int threads;
+    const Topology *topology;
+public:
+    // threads == 0 splits the cores of the node between the ranks running on it;
+    // topology == nullptr keeps the MPI_COMM_WORLD rank order
+    HybridCalculation(const int P, const long long N_Max, const int threads = 0,
+                      const Topology *topology = nullptr) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->threads = threads;
+        this->topology = topology;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_HYBRIDCALCULATION_H
@@ -0,0 +1,35 @@
+//
+// Variant 4 - Carry-lookahead
+// Incoming carries are resolved with one MPI_Exscan instead of the rank chain.
+// With a Topology the blocks follow the nodes and move through the node leaders
+//
+
+#ifndef TEMA_3_LOOKAHEADCALCULATION_H
+#define TEMA_3_LOOKAHEADCALCULATION_H
+
+#include <mpi.h>
+#include "BigNumber.h"
+#include "Topology.h"
+
+class LookaheadCalculation {
+private:
+    int P;
+    long long N_Max;
+    const Topology *topology;
+public:
+    // topology == nullptr keeps the MPI_COMM_WORLD rank order
+    LookaheadCalculation(const int P, const long long N_Max, const Topology *topology = nullptr) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->topology = topology;
+    }
+    void run();
+    void calculator(int rank);
+    // carry-combine operator for MPI_Exscan over (generate, propagate) pairs
+    static void combineCarry(void *in, void *inout, int *len, MPI_Datatype *datatype);
+    // carry entering this rank's block, blocks are ordered by rank in comm
+    static BigNumber::Limb incomingCarry(BigNumber::Limb generate, bool propagate, MPI_Comm comm);
+};
+
+
+#endif //TEMA_3_LOOKAHEADCALCULATION_H
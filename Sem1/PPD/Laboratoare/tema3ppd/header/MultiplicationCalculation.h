@@ -0,0 +1,22 @@
+//
+// Multiplication - the first operand is split in Scatterv blocks, the second is broadcast;
+// every process multiplies its block (schoolbook or Karatsuba), master adds the shifted products
+//
+
+#ifndef TEMA_3_MULTIPLICATIONCALCULATION_H
+#define TEMA_3_MULTIPLICATIONCALCULATION_H
+
+
+class MultiplicationCalculation {
+private:
+    int P;
+public:
+    explicit MultiplicationCalculation(const int P) {
+        this->P = P;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_MULTIPLICATIONCALCULATION_H
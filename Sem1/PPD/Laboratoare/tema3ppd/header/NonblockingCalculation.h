@@ -0,0 +1,36 @@
+//
+// Variant 8 - Non-blocking collectives
+// Every block is cut in chunks, each chunk is its own MPI_Iscatterv/MPI_Igatherv: all the scatters
+// are posted at once, a chunk is added as soon as it lands and its gather overlaps the next chunks.
+// Process 0 resolves the carries from the block carries, as in Variant 3.
+// With a Topology the blocks follow the nodes; the chunked collectives stay flat
+//
+
+#ifndef TEMA_3_NONBLOCKINGCALCULATION_H
+#define TEMA_3_NONBLOCKINGCALCULATION_H
+
+#include "Topology.h"
+
+class NonblockingCalculation {
+private:
+    int P;
+    long long N_Max;
+    int chunks;
+    const Topology *topology;
+public:
+    static const int DEFAULT_CHUNKS = 8;
+
+    // topology == nullptr keeps the MPI_COMM_WORLD rank order
+    NonblockingCalculation(const int P, const long long N_Max, const int chunks = DEFAULT_CHUNKS,
+                           const Topology *topology = nullptr) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->chunks = chunks > 0 ? chunks : DEFAULT_CHUNKS;
+        this->topology = topology;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_NONBLOCKINGCALCULATION_H
@@ -0,0 +1,24 @@
+//
+// Variant 5 - Parallel MPI-IO
+// Every process reads its own slice of the inputs and writes its own slice of the result
+//
+
+#ifndef TEMA_3_PARALLELIOCALCULATION_H
+#define TEMA_3_PARALLELIOCALCULATION_H
+
+
+class ParallelIOCalculation {
+private:
+    int P;
+    long long N_Max;
+public:
+    ParallelIOCalculation(const int P, const long long N_Max) {
+        this->P = P;
+        this->N_Max = N_Max;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_PARALLELIOCALCULATION_H
@@ -0,0 +1,34 @@
+//
+// Reduction - sum of many operands: every process adds its operand files in carry-save form,
+// one MPI_Reduce (MPI_SUM over the accumulator words) combines them, carries are normalized once
+//
+
+#ifndef TEMA_3_REDUCTIONCALCULATION_H
+#define TEMA_3_REDUCTIONCALCULATION_H
+
+#include <string>
+#include <vector>
+#include "BigNumber.h"
+using namespace std;
+
+class ReductionCalculation {
+private:
+    int P;
+    vector<string> operandFiles;
+public:
+    ReductionCalculation(const int P, const vector<string> &operandFiles) {
+        this->P = P;
+        this->operandFiles = operandFiles;
+    }
+    void run();
+    void calculator(int rank);
+    // binary number files, one name per line; empty if the list could not be opened
+    static vector<string> readOperandList(const string &listFile);
+    // limbs that hold the sum of count operands with at most numberOfDigits digits
+    static long long resultSize(long long numberOfDigits, long long count);
+    // writes the digits of the sum up to its most significant nonzero one
+    static void writeSum(const string &fileName, const BigNumber::Limb *number, long long size);
+};
+
+
+#endif //TEMA_3_REDUCTIONCALCULATION_H
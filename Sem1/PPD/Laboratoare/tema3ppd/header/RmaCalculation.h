@@ -0,0 +1,44 @@
+//
+// Variant 7 - One-sided carry (MPI RMA)
+// Scatterv blocks, every carry hop is an MPI_Put into the successor's slot of an MPI_Win
+// instead of an MPI_Send/MPI_Recv rendezvous; the window is in shared memory when all the
+// processes are on one node. With a Topology the blocks follow the nodes, so only one carry
+// put per node boundary leaves the node
+//
+
+#ifndef TEMA_3_RMACALCULATION_H
+#define TEMA_3_RMACALCULATION_H
+
+#include <mpi.h>
+#include "BigNumber.h"
+#include "Topology.h"
+
+class RmaCalculation {
+private:
+    int P;
+    long long N_Max;
+    const Topology *topology;
+public:
+    // slots of the carry window on every process: the carry coming from the previous process
+    // and, on process 0, the carry out of the number. A slot holds carry + 1 once written
+    enum Slot { INCOMING, FINAL, SLOTS };
+
+    // topology == nullptr keeps the MPI_COMM_WORLD rank order
+    RmaCalculation(const int P, const long long N_Max, const Topology *topology = nullptr) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->topology = topology;
+    }
+    void run();
+    void calculator(int rank);
+    // collective: SLOTS empty slots per process, locked for passive-target access by every
+    // process; shared is true when the window is in shared memory (MPI_Win_allocate_shared)
+    static MPI_Win allocateCarryWindow(MPI_Comm comm, BigNumber::Limb *&slots, bool &shared);
+    // writes carry into slot of process target, complete at the target on return
+    static void putCarry(MPI_Win window, bool shared, int target, Slot slot, BigNumber::Limb carry);
+    // polls slot of this process until a carry is written into it
+    static BigNumber::Limb waitCarry(MPI_Win window, bool shared, BigNumber::Limb *slots, int rank, Slot slot);
+};
+
+
+#endif //TEMA_3_RMACALCULATION_H
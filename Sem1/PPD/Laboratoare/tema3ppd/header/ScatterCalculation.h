@@ -9,16 +9,14 @@
 class ScatterCalculation {
 private:
     int P;
-    int N_Max;
+    long long N_Max;
 public:
-   ScatterCalculation(const int P, const int N_Max) {
+   ScatterCalculation(const int P, const long long N_Max) {
         this->P = P;
         this->N_Max = N_Max;
     }
     void run();
     void calculator(int rank);
-    int sum(const int *firstNumber, const int *secondNumber, int *result, int size);
-    void passCarry(int* number,int size,int &carry);
 };
 
 
@@ -0,0 +1,40 @@
+//
+// Variant 2.1 - Scatterv/Gatherv
+// Same as Variant 2 but with exact per-process counts, nothing is padded.
+// With a Topology the blocks follow the nodes and move through the node leaders
+//
+
+#ifndef TEMA_3_SCATTERVCALCULATION_H
+#define TEMA_3_SCATTERVCALCULATION_H
+
+#include <mpi.h>
+#include "BigNumber.h"
+#include "Topology.h"
+
+class ScattervCalculation {
+private:
+    int P;
+    long long N_Max;
+    const Topology *topology;
+public:
+    // topology == nullptr keeps the MPI_COMM_WORLD rank order
+    ScattervCalculation(const int P, const long long N_Max, const Topology *topology = nullptr) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->topology = topology;
+    }
+    void run();
+    void calculator(int rank);
+    // blocks of totalSize limbs, the first totalSize % P processes get one limb more
+    static void blockLayout(int totalSize, int P, int *blockStart, int *blockSize);
+    // counts and displacements of an operand of size limbs, cut along the result blocks
+    static void operandLayout(const int *blockStart, const int *blockSize, int P, int size,
+                              int *counts, int *displacements);
+    // scatters the size limbs of number (only read on root 0) along the blocks; local gets
+    // blockSize[rank] limbs, the ones past the end of the number are 0
+    static void scatterBlocks(const BigNumber::Limb *number, int size, const int *blockStart, const int *blockSize,
+                              BigNumber::Limb *local, MPI_Comm comm);
+};
+
+
+#endif //TEMA_3_SCATTERVCALCULATION_H
@@ -1,20 +1,21 @@
 #pragma once
+#include "BigNumber.h"
 class SequentialCalculation
 {
 private:
-	int* numberOne;
-	int* numberTwo;
-	int N1;
-	int N2;
+	const BigNumber &numberOne;
+	const BigNumber &numberTwo;
 public:
-	SequentialCalculation(int *number_one, int *number_two, int n1, int n2)
+	SequentialCalculation(const BigNumber &number_one, const BigNumber &number_two)
 		: numberOne(number_one),
-		  numberTwo(number_two),
-		  N1(n1),
-		  N2(n2) {
+		  numberTwo(number_two) {
 	}
 
-	int* calculate();
+	BigNumber calculate();
+	// |numberOne - numberTwo| on as many digits as the longer number, negative if numberOne < numberTwo
+	BigNumber subtract(bool &negative);
+	// -1, 0 or 1 as numberOne <, == or > numberTwo
+	int compare();
+	BigNumber multiply();
 
 };
-
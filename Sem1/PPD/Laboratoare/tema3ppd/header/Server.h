@@ -0,0 +1,27 @@
+//
+// Server mode - the MPI processes stay resident and run one job per connection on a UNIX socket
+// Job line: "<variant> [N1 N2]" (new random operands when the sizes are given), or "quit"
+// Reply line: "ok <seconds>" or "error <reason>"
+//
+
+#ifndef TEMA_3_SERVER_H
+#define TEMA_3_SERVER_H
+
+#include <functional>
+#include <string>
+#include "GenerateNumber.h"
+using namespace std;
+
+class Server {
+public:
+    // collective: process 0 accepts the jobs, the other processes wait for them in MPI_Bcast;
+    // new operands are generated with the generate options; execute runs one job on every process
+    // and returns false for an unknown variant
+    static void serve(const string &socketPath, const GenerateNumber::Options &generate,
+                      const function<bool(int variant, long long N_Max)> &execute);
+    // client side, runs without MPI: sends one job line and prints the reply, returns the exit code
+    static int request(const string &socketPath, const string &job);
+};
+
+
+#endif //TEMA_3_SERVER_H
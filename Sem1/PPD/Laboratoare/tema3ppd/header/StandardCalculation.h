@@ -6,16 +6,17 @@
 class StandardCalculation {
 private:
     int P;
-    int N_Max;
+    long long N_Max;
+    bool masterWorks;
 public:
-    StandardCalculation(const int P, const int N_Max) {
+    // masterWorks: process 0 also adds the first block instead of only coordinating
+    StandardCalculation(const int P, const long long N_Max, const bool masterWorks = false) {
         this->P = P;
         this->N_Max = N_Max;
+        this->masterWorks = masterWorks;
     }
     void run();
     void calculator(int rank);
-    int sum(const int *firstNumber, const int *secondNumber, int *result, int size);
-    void passCarry(int* number,int size,int &carry);
 };
 
 
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include "BigNumber.h"
+using namespace std;
+
+// Out-of-core sequential addition: both operands are streamed from their binary files in
+// windows of windowSize limbs and the sum is written as it goes, memory stays bounded
+// whatever the size of the numbers
+class StreamingCalculation
+{
+private:
+	string firstFile;
+	string secondFile;
+	string resultFile;
+	int windowSize;
+public:
+	// 3 buffers of 2^20 limbs (4 MiB each) plus the digit buffer
+	static const int DEFAULT_WINDOW_SIZE = 1 << 20;
+
+	StreamingCalculation(const string &first_file, const string &second_file, const string &result_file,
+	                     const int window_size = DEFAULT_WINDOW_SIZE)
+		: firstFile(first_file),
+		  secondFile(second_file),
+		  resultFile(result_file),
+		  windowSize(window_size > 0 ? window_size : DEFAULT_WINDOW_SIZE) {
+	}
+
+	// writes the sum in the binary format, false if an operand could not be read
+	bool calculate();
+
+};
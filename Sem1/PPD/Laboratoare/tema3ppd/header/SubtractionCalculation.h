@@ -0,0 +1,24 @@
+//
+// Subtraction - Scatterv blocks, borrows resolved with the MPI_Exscan of Variant 4
+// The result is |first - second|, followed by a "-" when first < second
+//
+
+#ifndef TEMA_3_SUBTRACTIONCALCULATION_H
+#define TEMA_3_SUBTRACTIONCALCULATION_H
+
+
+class SubtractionCalculation {
+private:
+    int P;
+    long long N_Max;
+public:
+    SubtractionCalculation(const int P, const long long N_Max) {
+        this->P = P;
+        this->N_Max = N_Max;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_SUBTRACTIONCALCULATION_H
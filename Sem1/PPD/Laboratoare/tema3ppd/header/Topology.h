@@ -0,0 +1,51 @@
+//
+// Topology-aware placement of the blocks
+// The processes are renumbered node by node, so consecutive blocks sit on one node and a carry
+// chain crosses every node boundary once; the node leaders (first process of every node)
+// move the operands and the results of their node to and from process 0
+//
+
+#ifndef TEMA_3_TOPOLOGY_H
+#define TEMA_3_TOPOLOGY_H
+
+#include <mpi.h>
+#include <vector>
+#include "BigNumber.h"
+
+class Topology {
+private:
+    // blocks of node k: ranks [nodeFirst[k], nodeFirst[k] + nodeSize[k]) of the blocks communicator
+    std::vector<int> nodeFirst;
+    std::vector<int> nodeSize;
+    int nodeIndex;
+
+    // limbs [start, start + length) covered by the blocks of node k
+    void nodeRange(const int *blockStart, const int *blockSize, int k, int &start, int &length) const;
+public:
+    // same processes as the world, node by node; rank 0 stays rank 0
+    MPI_Comm blocks;
+    // processes of this node, in block order
+    MPI_Comm node;
+    // rank 0 of every node in node order, MPI_COMM_NULL on the other processes
+    MPI_Comm leaders;
+
+    // collective over comm: nodes from MPI_COMM_TYPE_SHARED, or TOPOLOGY_NODES=n nodes with the
+    // ranks dealt round-robin (a launcher mapping by node, to try the hierarchy on one machine)
+    explicit Topology(MPI_Comm comm);
+    ~Topology();
+    Topology(const Topology &) = delete;
+    Topology &operator=(const Topology &) = delete;
+
+    int nodes() const {
+        return (int) nodeSize.size();
+    }
+    // as ScattervCalculation::scatterBlocks over blocks, through the node leaders
+    void scatterBlocks(const BigNumber::Limb *number, int size, const int *blockStart, const int *blockSize,
+                       BigNumber::Limb *local) const;
+    // gathers blockSize[rank] limbs of every process into result (only on rank 0), through the node leaders
+    void gatherBlocks(const BigNumber::Limb *local, const int *blockStart, const int *blockSize,
+                      BigNumber::Limb *result) const;
+};
+
+
+#endif //TEMA_3_TOPOLOGY_H
@@ -4,8 +4,14 @@ using namespace std;
 
 class Verification {
 public:
+    // firstDifference result when a file is missing or holds no digits
+    static const long long UNREADABLE = -2;
+
+    // streams both files (binary or text) in chunks: -1 if they hold the same digits,
+    // otherwise the index of the first differing digit (least significant digit is 0)
+    static long long firstDifference(const string& file1, const string& file2);
     static bool compareResults(const string& file1, const string& file2);
+    // with --checksum the sidecar hashes are compared, a missing sidecar is a failure
     static void printComparison(const string& variantName, const string& referenceFile, const string& testFile);
     static void runAllVerifications();
 };
-
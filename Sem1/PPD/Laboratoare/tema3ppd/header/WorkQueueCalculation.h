@@ -0,0 +1,36 @@
+//
+// Variant 9 - Dynamic load balancing (work queue)
+// Process 0 hands out fixed-size chunks on demand: a worker gets its next chunk when it returns
+// a result, so faster processes add more chunks. Results are placed by their offset and the
+// carries are resolved at the end from a (carry out, all 9s) summary of every chunk
+//
+
+#ifndef TEMA_3_WORKQUEUECALCULATION_H
+#define TEMA_3_WORKQUEUECALCULATION_H
+
+
+class WorkQueueCalculation {
+private:
+    int P;
+    long long N_Max;
+    int chunkSize;
+    bool masterWorks;
+public:
+    // limbs per chunk and chunks handed to a worker ahead of its results
+    static const int DEFAULT_CHUNK_SIZE = 16384;
+    static const int PREFETCH = 2;
+
+    // masterWorks: process 0 also adds chunks while no result is waiting
+    WorkQueueCalculation(const int P, const long long N_Max, const bool masterWorks = false,
+                         const int chunkSize = DEFAULT_CHUNK_SIZE) {
+        this->P = P;
+        this->N_Max = N_Max;
+        this->masterWorks = masterWorks;
+        this->chunkSize = chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE;
+    }
+    void run();
+    void calculator(int rank);
+};
+
+
+#endif //TEMA_3_WORKQUEUECALCULATION_H
@@ -1,13 +1,34 @@
 #include <mpi.h>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "header/GenerateNumber.h"
 #include "header/ScatterCalculation.h"
 #include "header/SequentialCalculation.h"
+#include "header/StreamingCalculation.h"
 #include "header/StandardCalculation.h"
 #include "header/AsyncCalculation.h"
 #include "header/OptimizedCalculation.h"
+#include "header/LookaheadCalculation.h"
+#include "header/ParallelIOCalculation.h"
+#include "header/ScattervCalculation.h"
+#include "header/HybridCalculation.h"
+#include "header/RmaCalculation.h"
+#include "header/NonblockingCalculation.h"
+#include "header/WorkQueueCalculation.h"
+#include "header/SubtractionCalculation.h"
+#include "header/ComparisonCalculation.h"
+#include "header/MultiplicationCalculation.h"
+#include "header/ReductionCalculation.h"
+#include "header/Topology.h"
+#include "header/Server.h"
+#include "header/BufferPool.h"
+#include "header/Checksum.h"
 #include "header/Verification.h"
+#include "header/Benchmark.h"
 
 using namespace std;
 
@@ -23,6 +44,17 @@ void printMenu() {
     cout << "  4 - Variant 1.1: Optimized (addition before carry)" << endl;
     cout << "  5 - Run ALL variants + verification" << endl;
     cout << "  6 - Verification only (compare existing results)" << endl;
+    cout << "  7 - Variant 4: Carry-lookahead (MPI_Exscan)" << endl;
+    cout << "  8 - Variant 5: Parallel MPI-IO (every process reads/writes its slice)" << endl;
+    cout << "  9 - Variant 2.1: Scatterv/Gatherv (no padding)" << endl;
+    cout << " 10 - Variant 6: Hybrid MPI + threads" << endl;
+    cout << " 11 - Subtraction (borrows via MPI_Exscan)" << endl;
+    cout << " 12 - Comparison (MPI_Allreduce MAXLOC)" << endl;
+    cout << " 13 - Multiplication (schoolbook/Karatsuba per process)" << endl;
+    cout << " 14 - Sum of many operands (--operands list, carry-save MPI_Reduce)" << endl;
+    cout << " 15 - Variant 7: One-sided carry (MPI RMA window)" << endl;
+    cout << " 16 - Variant 8: Non-blocking collectives (MPI_Iscatterv/MPI_Igatherv)" << endl;
+    cout << " 17 - Variant 9: Dynamic load balancing (work queue)" << endl;
     cout << "========================================" << endl;
     cout << "Choice: ";
 }
@@ -31,7 +63,7 @@ void printOutputInfo(int choice) {
     cout << "\n========== OUTPUT FILE INFO ==========" << endl;
     switch(choice) {
         case 0:
-            cout << "Output: result.txt" << endl;
+            cout << "Output: result.bin" << endl;
             cout << "Description: Sequential calculation (reference)" << endl;
             break;
         case 1:
@@ -52,81 +84,498 @@ void printOutputInfo(int choice) {
             break;
         case 5:
             cout << "Outputs:" << endl;
-            cout << "  - result.txt (Sequential)" << endl;
+            cout << "  - result.bin (Sequential)" << endl;
             cout << "  - result1.txt (Variant 1)" << endl;
             cout << "  - resultScatter.txt (Variant 2)" << endl;
             cout << "  - resultAsync.txt (Variant 3)" << endl;
             cout << "  - resultOptimized.txt (Variant 1.1)" << endl;
+            cout << "  - resultLookahead.txt (Variant 4)" << endl;
+            cout << "  - resultParallelIO.txt (Variant 5)" << endl;
+            cout << "  - resultScatterv.txt (Variant 2.1)" << endl;
+            cout << "  - resultHybrid.txt (Variant 6)" << endl;
+            cout << "  - resultRma.txt (Variant 7)" << endl;
+            cout << "  - resultNonblocking.txt (Variant 8)" << endl;
+            cout << "  - resultWorkQueue.txt (Variant 9)" << endl;
+            break;
+        case 7:
+            cout << "Output: resultLookahead.txt" << endl;
+            cout << "Description: Variant 4 - Carry-lookahead (carries resolved with one MPI_Exscan)" << endl;
+            break;
+        case 8:
+            cout << "Output: resultParallelIO.txt" << endl;
+            cout << "Description: Variant 5 - Parallel MPI-IO (MPI_File_read_at_all/MPI_File_write_at_all)" << endl;
+            break;
+        case 9:
+            cout << "Output: resultScatterv.txt" << endl;
+            cout << "Description: Variant 2.1 - Scatterv/Gatherv with exact counts, no padding" << endl;
+            break;
+        case 10:
+            cout << "Output: resultHybrid.txt" << endl;
+            cout << "Description: Variant 6 - Hybrid MPI + std::thread team inside every process" << endl;
+            break;
+        case 11:
+            cout << "Output: resultSubtract.txt (reference resultSubtractSeq.txt)" << endl;
+            cout << "Description: |first - second|, \"-\" at the end if negative; borrows resolved with MPI_Exscan" << endl;
+            break;
+        case 12:
+            cout << "Output: resultCompare.txt (reference resultCompareSeq.txt)" << endl;
+            cout << "Description: -1, 0 or 1; most significant differing limb found with MPI_Allreduce" << endl;
+            break;
+        case 13:
+            cout << "Output: resultMultiply.txt (reference resultMultiplySeq.txt)" << endl;
+            cout << "Description: first * second; block products (schoolbook/Karatsuba) added on process 0" << endl;
+            break;
+        case 14:
+            cout << "Output: resultReduce.txt (reference resultReduceSeq.txt)" << endl;
+            cout << "Description: sum of the --operands files; carry-save partial sums, one MPI_Reduce, carries normalized once" << endl;
+            break;
+        case 15:
+            cout << "Output: resultRma.txt" << endl;
+            cout << "Description: Variant 7 - carries MPI_Put into the next process's MPI_Win slot (shared memory on one node)" << endl;
+            break;
+        case 16:
+            cout << "Output: resultNonblocking.txt" << endl;
+            cout << "Description: Variant 8 - chunked MPI_Iscatterv/MPI_Igatherv overlapped with the additions" << endl;
+            break;
+        case 17:
+            cout << "Output: resultWorkQueue.txt" << endl;
+            cout << "Description: Variant 9 - process 0 hands out fixed-size chunks on demand, faster processes add more" << endl;
             break;
     }
     cout << "========================================\n" << endl;
 }
 
+// Variants run by choice 5, in this order
+const int ALL_VARIANTS[] = {1, 2, 3, 4, 7, 8, 9, 10, 15, 16, 17};
+
+string variantName(int choice) {
+    switch(choice) {
+        case 0: return "Sequential";
+        case 1: return "Variant 1 (Standard)";
+        case 2: return "Variant 2 (Scatter/Gather)";
+        case 3: return "Variant 3 (Async)";
+        case 4: return "Variant 1.1 (Optimized)";
+        case 7: return "Variant 4 (Carry-lookahead)";
+        case 8: return "Variant 5 (Parallel MPI-IO)";
+        case 9: return "Variant 2.1 (Scatterv/Gatherv)";
+        case 10: return "Variant 6 (Hybrid MPI + threads)";
+        case 11: return "Subtraction";
+        case 12: return "Comparison";
+        case 13: return "Multiplication";
+        case 14: return "Reduction (many operands)";
+        case 15: return "Variant 7 (One-sided RMA carry)";
+        case 16: return "Variant 8 (Non-blocking collectives)";
+        case 17: return "Variant 9 (Work queue)";
+    }
+    return "";
+}
+
+// Result file of an addition variant (0 is the reference), "" for the other operations
+string resultFile(int choice) {
+    switch(choice) {
+        case 0: return "result.bin";
+        case 1: return "result1.txt";
+        case 2: return "resultScatter.txt";
+        case 3: return "resultAsync.txt";
+        case 4: return "resultOptimized.txt";
+        case 7: return "resultLookahead.txt";
+        case 8: return "resultParallelIO.txt";
+        case 9: return "resultScatterv.txt";
+        case 10: return "resultHybrid.txt";
+        case 15: return "resultRma.txt";
+        case 16: return "resultNonblocking.txt";
+        case 17: return "resultWorkQueue.txt";
+    }
+    return "";
+}
+
+// Reference result, process 0 only; out of core the operands are never fully in memory
+void runSequential(int choice, bool outOfCore, int window, const vector<string> &operandFiles) {
+    if (choice == 14) {
+        // pairwise additions, the carries are normalized after every operand
+        long long maxDigits = 0;
+        for (const string &fileName: operandFiles) {
+            maxDigits = max(maxDigits, GenerateNumber::readNumberOfDigits(fileName));
+        }
+        const long long size = ReductionCalculation::resultSize(maxDigits, (long long) operandFiles.size());
+        BigNumber result(size * BigNumber::DIGITS_PER_LIMB);
+        for (const string &fileName: operandFiles) {
+            BigNumber number = GenerateNumber::readNumber(fileName);
+            BigNumber::sum(result.data(), size, number.data(), number.getSize(), result.data(), size);
+        }
+        Benchmark::lap(Benchmark::COMPUTE);
+        ReductionCalculation::writeSum("resultReduceSeq.txt", result.data(), size);
+        Benchmark::lap(Benchmark::WRITE);
+        return;
+    }
+    if (choice >= 11 && choice <= 13) {
+        // references of the other operations, same text layout as their parallel results
+        BigNumber firstNumber = GenerateNumber::readNumber("firstNumber.bin");
+        BigNumber secondNumber = GenerateNumber::readNumber("secondNumber.bin");
+        Benchmark::lap(Benchmark::READ);
+        SequentialCalculation calculation(firstNumber, secondNumber);
+        if (choice == 11) {
+            bool negative;
+            BigNumber number = calculation.subtract(negative);
+            Benchmark::lap(Benchmark::COMPUTE);
+            ofstream out("resultSubtractSeq.txt");
+            BigNumber::writeDigits(out, number.data(), number.getSize(), number.getNumberOfDigits());
+            if (negative) {
+                out << "-\n";
+            }
+        } else if (choice == 12) {
+            const int order = calculation.compare();
+            Benchmark::lap(Benchmark::COMPUTE);
+            ofstream out("resultCompareSeq.txt");
+            out << order << "\n";
+        } else {
+            BigNumber number = calculation.multiply();
+            Benchmark::lap(Benchmark::COMPUTE);
+            ofstream out("resultMultiplySeq.txt");
+            BigNumber::writeDigits(out, number.data(), number.getSize(), number.getNumberOfDigits());
+        }
+        Benchmark::lap(Benchmark::WRITE);
+        return;
+    }
+    // the hash of an earlier run must not survive the new result.bin
+    Checksum::remove(resultFile(0));
+    if (outOfCore) {
+        StreamingCalculation calculation("firstNumber.bin", "secondNumber.bin", "result.bin", window);
+        calculation.calculate();
+        Benchmark::lap(Benchmark::COMPUTE);
+        return;
+    }
+    BigNumber firstNumber = GenerateNumber::readNumber("firstNumber.bin");
+    BigNumber secondNumber = GenerateNumber::readNumber("secondNumber.bin");
+    Benchmark::lap(Benchmark::READ);
+
+    SequentialCalculation calculation(firstNumber, secondNumber);
+    BigNumber number = calculation.calculate();
+    Benchmark::lap(Benchmark::COMPUTE);
+    GenerateNumber::writeNumber("result.bin", number);
+    if (Checksum::enabled) {
+        Checksum::write("result.bin", Checksum::hash(number.data(), number.getSize(), 0));
+    }
+    Benchmark::lap(Benchmark::WRITE);
+}
+
+// Runs one parallel variant on every process, false if choice is not one
+bool runVariant(int choice, int P, long long N_MAX, bool masterWorks, int threads, int chunkSize,
+                const vector<string> &operandFiles, const Topology *topology) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0 && !resultFile(choice).empty()) {
+        Checksum::remove(resultFile(choice));
+    }
+    switch(choice) {
+        case 1: {
+            StandardCalculation calculator(P, N_MAX, masterWorks);
+            calculator.run();
+            return true;
+        }
+        case 2: {
+            ScatterCalculation calculatorS(P, N_MAX);
+            calculatorS.run();
+            return true;
+        }
+        case 3: {
+            AsyncCalculation calculatorA(P, N_MAX, masterWorks, chunkSize);
+            calculatorA.run();
+            return true;
+        }
+        case 4: {
+            OptimizedCalculation calculatorOpt(P, N_MAX, masterWorks);
+            calculatorOpt.run();
+            return true;
+        }
+        case 7: {
+            LookaheadCalculation calculatorL(P, N_MAX, topology);
+            calculatorL.run();
+            return true;
+        }
+        case 8: {
+            ParallelIOCalculation calculatorIO(P, N_MAX);
+            calculatorIO.run();
+            return true;
+        }
+        case 9: {
+            ScattervCalculation calculatorSv(P, N_MAX, topology);
+            calculatorSv.run();
+            return true;
+        }
+        case 10: {
+            HybridCalculation calculatorH(P, N_MAX, threads, topology);
+            calculatorH.run();
+            return true;
+        }
+        case 11: {
+            SubtractionCalculation calculatorSub(P, N_MAX);
+            calculatorSub.run();
+            return true;
+        }
+        case 12: {
+            ComparisonCalculation calculatorC(P, N_MAX);
+            calculatorC.run();
+            return true;
+        }
+        case 13: {
+            MultiplicationCalculation calculatorM(P);
+            calculatorM.run();
+            return true;
+        }
+        case 14: {
+            ReductionCalculation calculatorR(P, operandFiles);
+            calculatorR.run();
+            return true;
+        }
+        case 15: {
+            RmaCalculation calculatorRma(P, N_MAX, topology);
+            calculatorRma.run();
+            return true;
+        }
+        case 16: {
+            NonblockingCalculation calculatorNb(P, N_MAX, NonblockingCalculation::DEFAULT_CHUNKS, topology);
+            calculatorNb.run();
+            return true;
+        }
+        case 17: {
+            WorkQueueCalculation calculatorQ(P, N_MAX, masterWorks, chunkSize);
+            calculatorQ.run();
+            return true;
+        }
+    }
+    return false;
+}
+
 int main(int argc, char **argv) {
-    if (argc < 3) {
-        cerr << "Usage: " << argv[0] << " <N1> <N2> [variant]" << endl;
+    // Format conversion runs without MPI
+    if (argc == 4 && string(argv[1]) == "--to-binary") {
+        return GenerateNumber::convertTextToBinary(argv[2], argv[3]) ? 0 : 1;
+    }
+    if (argc == 4 && string(argv[1]) == "--to-text") {
+        return GenerateNumber::convertBinaryToText(argv[2], argv[3]) ? 0 : 1;
+    }
+    // client of the server mode, no MPI either
+    if (argc == 4 && string(argv[1]) == "--request") {
+        return Server::request(argv[2], argv[3]);
+    }
+
+    // Options start with "--", everything else is positional
+    vector<string> arguments;
+    bool masterWorks = false;
+    int threads = 0;
+    int chunkSize = 0;
+    int repetitions = 0;
+    int warmup = 1;
+    string reportFile = "benchmark.csv";
+    bool outOfCore = false;
+    int window = StreamingCalculation::DEFAULT_WINDOW_SIZE;
+    string operandList;
+    string socketPath;
+    GenerateNumber::Options generate;
+    int blocks = 0;
+    bool placement = false;
+    for (int i = 1; i < argc; i++) {
+        const string argument = argv[i];
+        if (argument == "--master-works") {
+            masterWorks = true;
+        } else if (argument == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (argument == "--chunk" && i + 1 < argc) {
+            chunkSize = atoi(argv[++i]);
+        } else if (argument == "--benchmark" && i + 1 < argc) {
+            repetitions = atoi(argv[++i]);
+        } else if (argument == "--warmup" && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+        } else if (argument == "--report" && i + 1 < argc) {
+            reportFile = argv[++i];
+        } else if (argument == "--out-of-core") {
+            outOfCore = true;
+        } else if (argument == "--window" && i + 1 < argc) {
+            window = atoi(argv[++i]);
+        } else if (argument == "--operands" && i + 1 < argc) {
+            operandList = argv[++i];
+        } else if (argument == "--seed" && i + 1 < argc) {
+            generate.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--profile" && i + 1 < argc) {
+            if (!GenerateNumber::parseProfile(argv[++i], generate.profile)) {
+                cerr << "Unknown profile " << argv[i] << endl;
+                return 1;
+            }
+        } else if (argument == "--blocks" && i + 1 < argc) {
+            blocks = atoi(argv[++i]);
+        } else if (argument == "--topology") {
+            placement = true;
+        } else if (argument == "--checksum") {
+            Checksum::enabled = true;
+        } else if (argument == "--serve" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+
+    if (arguments.size() < 2 && socketPath.empty()) {
+        cerr << "Usage: " << argv[0] << " <N1> <N2> [variant] [--master-works] [--threads T] [--chunk L]"
+             << " [--benchmark R [--warmup W] [--report file]] [--out-of-core [--window L]]"
+             << " [--operands list] [--checksum] [--seed S] [--profile name] [--blocks B] [--topology]" << endl;
+        cerr << "       " << argv[0] << " --serve <socket> [options]" << endl;
         cerr << "  N1: Number of digits in first number" << endl;
         cerr << "  N2: Number of digits in second number" << endl;
-        cerr << "  variant: Optional (0-6), if not provided, shows menu" << endl;
+        cerr << "  variant: Optional (0-17), if not provided, shows menu" << endl;
+        cerr << "  --master-works: process 0 also adds a block in variants 1, 3 and 1.1, chunks in variant 9" << endl;
+        cerr << "  --threads T: threads per process in variant 6 (default: cores of the node / processes on it)" << endl;
+        cerr << "  --chunk L: limbs per chunk in variants 3 and 9 (default " << AsyncCalculation::DEFAULT_CHUNK_SIZE << ")" << endl;
+        cerr << "  --benchmark R: time the variant(s) R times after W warm-up runs (default 1)," << endl;
+        cerr << "                 results appended to file (default benchmark.csv, JSON lines for .json)" << endl;
+        cerr << "  --out-of-core: the sequential reference streams the operands from disk in windows" << endl;
+        cerr << "                 of L limbs (default " << StreamingCalculation::DEFAULT_WINDOW_SIZE << "), for numbers larger than RAM" << endl;
+        cerr << "  --operands list: binary number files (one per line) added by variant 14," << endl;
+        cerr << "                   default firstNumber.bin and secondNumber.bin" << endl;
+        cerr << "  --checksum: variants hash their result blocks while computing, the verification" << endl;
+        cerr << "              compares the hashes (<result file>.sum) instead of reading the results" << endl;
+        cerr << "  --seed S: seed of the generated operands (default " << GenerateNumber::DEFAULT_SEED << "), same digits for any P" << endl;
+        cerr << "  --profile name: carry profile of the operands: random (default), nines (one chain over" << endl;
+        cerr << "       the whole sum), alternating (runs of 9s), boundary (a carry across every block" << endl;
+        cerr << "       boundary), block-nines (every other block a run of 9s)" << endl;
+        cerr << "  --blocks B: blocks of boundary and block-nines (default: the workers, P - 1 or P with --master-works)" << endl;
+        cerr << "  --topology: variants 4, 2.1, 6, 7 and 8 order the blocks node by node; except in 8 the node" << endl;
+        cerr << "              leaders move the operands and results of their node (TOPOLOGY_NODES=n simulates n nodes)." << endl;
+        cerr << "              Variants 1, 2, 3, 1.1, 5, 9 and 11-14 ignore it" << endl;
+        cerr << "  --serve socket: stay resident and run the jobs sent with --request (no N1 N2 needed)" << endl;
+        cerr << "       " << argv[0] << " --request <socket> \"<variant> [N1 N2]\" | quit" << endl;
+        cerr << "       " << argv[0] << " --to-binary <text file> <binary file>" << endl;
+        cerr << "       " << argv[0] << " --to-text <binary file> <text file>" << endl;
         return 1;
     }
     
-    int N1 = atoi(argv[1]);
-    int N2 = atoi(argv[2]);
+    long long N1 = arguments.size() >= 2 ? atoll(arguments[0].c_str()) : 0;
+    long long N2 = arguments.size() >= 2 ? atoll(arguments[1].c_str()) : 0;
     int choice = -1;
 
-    int N_MAX;
+    long long N_MAX;
     if (N1 > N2) {
         N_MAX = N1;
     } else {
         N_MAX = N2;
     }
 
-    // Initialize MPI first
-    MPI_Init(&argc, &argv);
+    // Initialize MPI first, only the main thread makes MPI calls (Variant 6 threads just add)
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
     int P, rank;
     MPI_Comm_size(MPI_COMM_WORLD, &P);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    generate.blocks = blocks > 0 ? blocks : (masterWorks || P == 1 ? P : P - 1);
+    // built once, the communicators are reused by every run
+    Topology *topology = placement ? new Topology(MPI_COMM_WORLD) : nullptr;
+
+    // every process reads the operand list itself, the files are on a shared file system
+    vector<string> operandFiles = {"firstNumber.bin", "secondNumber.bin"};
+    if (!operandList.empty()) {
+        operandFiles = ReductionCalculation::readOperandList(operandList);
+    }
+
+    if (!socketPath.empty()) {
+        // Server mode: MPI_Init and MPI_Finalize are paid once for all the jobs
+        Server::serve(socketPath, generate, [&](int variant, long long N_Max) {
+            if (variant == 0) {
+                if (rank == 0) runSequential(variant, outOfCore, window, operandFiles);
+                return true;
+            }
+            if (variant == 5) {
+                for (int other: ALL_VARIANTS) {
+                    runVariant(other, P, N_Max, masterWorks, threads, chunkSize, operandFiles, topology);
+                }
+                return true;
+            }
+            return runVariant(variant, P, N_Max, masterWorks, threads, chunkSize, operandFiles, topology);
+        });
+        delete topology;
+        BufferPool::clear();
+        MPI_Finalize();
+        return 0;
+    }
 
     // Only process 0 handles menu and generates numbers
     if (rank == 0) {
-        if (argc >= 4) {
-            choice = atoi(argv[3]);
+        if (arguments.size() >= 3) {
+            choice = atoi(arguments[2].c_str());
         } else {
             printMenu();
             cin >> choice;
         }
 
-        if (choice < 0 || choice > 6) {
+        if (choice < 0 || choice > 17) {
             cout << "Invalid choice! Running all variants..." << endl;
             choice = 5;
         }
 
         printOutputInfo(choice);
 
-        // Generate numbers
-        GenerateNumber::generateNumber("firstNumber.txt", N1);
-        GenerateNumber::generateNumber("secondNumber.txt", N2);
+        if (choice != 0 && choice != 6 && !BigNumber::fitsParallel(N_MAX, P)) {
+            cerr << "Numbers too large for the parallel variants, run variant 0 with --out-of-core" << endl;
+            choice = -1;
+        }
+
     }
 
     // Broadcast choice to all processes
     MPI_Bcast(&choice, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (choice < 0) {
+        delete topology;
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Generate numbers, every process writes its own region of the files
+    GenerateNumber::generateOperands(N1, N2, generate, MPI_COMM_WORLD);
+    if (rank == 0 && generate.profile != GenerateNumber::RANDOM) {
+        cout << "Operand profile: " << GenerateNumber::profileName(generate.profile) << " (" << generate.blocks
+             << " blocks)" << endl;
+    }
+    if (rank == 0 && topology != nullptr) {
+        cout << "Topology: " << topology->nodes() << " node(s), blocks ordered node by node" << endl;
+    }
 
     // Ensure all processes wait for file generation
     MPI_Barrier(MPI_COMM_WORLD);
 
+    if (repetitions > 0) {
+        // Benchmark mode: the sequential mean is the baseline for speedup and efficiency
+        Benchmark::Measurement sequential = Benchmark::measure(variantName(0), 1, N_MAX, warmup, repetitions,
+                                                               [&]() { if (rank == 0) runSequential(choice, outOfCore, window, operandFiles); });
+        Benchmark::compare(sequential, sequential.mean);
+        vector<Benchmark::Measurement> measurements = {sequential};
+        vector<int> variants(begin(ALL_VARIANTS), end(ALL_VARIANTS));
+        if (choice >= 11 && choice <= 14) {
+            variants = {choice};
+        }
+        for (int variant: variants) {
+            if (choice == 5 || choice == variant) {
+                measurements.push_back(Benchmark::measure(variantName(variant), P, N_MAX, warmup, repetitions,
+                                                          [&]() { runVariant(variant, P, N_MAX, masterWorks, threads, chunkSize, operandFiles, topology); }));
+                Benchmark::compare(measurements.back(), sequential.mean);
+            }
+        }
+        if (rank == 0) {
+            cout << "Sum kernel: " << BigNumber::sumKernelName() << endl;
+            for (Benchmark::Measurement &measurement: measurements) {
+                measurement.profile = GenerateNumber::profileName(generate.profile);
+                Benchmark::print(measurement);
+                Benchmark::report(reportFile, measurement);
+            }
+            cout << "Benchmark appended to " << reportFile << endl;
+        }
+        delete topology;
+        BufferPool::clear();
+        MPI_Finalize();
+        return 0;
+    }
+
     // Run sequential first (only process 0)
     if (rank == 0 && choice != 6) {
-        int *firstNumber = GenerateNumber::readNumber("firstNumber.txt");
-        int *secondNumber = GenerateNumber::readNumber("secondNumber.txt");
-
-        SequentialCalculation calculation(firstNumber, secondNumber, N1, N2);
-        int *number = calculation.calculate();
-        GenerateNumber::writeNumber("result.txt", number, N_MAX);
-        
-        delete[] firstNumber;
-        delete[] secondNumber;
-        delete[] number;
+        runSequential(choice, outOfCore, window, operandFiles);
 
         if (choice == 0) {
             cout << "✓ Sequential calculation completed" << endl;
@@ -137,62 +586,41 @@ int main(int argc, char **argv) {
 
     // Run selected variant(s)
     switch(choice) {
-        case 1: {
-            StandardCalculation calculator(P, N_MAX);
-            calculator.run();
-            if (rank == 0) cout << "✓ Variant 1 (Standard) completed" << endl;
-            break;
-        }
-        case 2: {
-            ScatterCalculation calculatorS(P, N_MAX);
-            calculatorS.run();
-            if (rank == 0) cout << "✓ Variant 2 (Scatter/Gather) completed" << endl;
-            break;
-        }
-        case 3: {
-            AsyncCalculation calculatorA(P, N_MAX);
-            calculatorA.run();
-            if (rank == 0) cout << "✓ Variant 3 (Async) completed" << endl;
-            break;
-        }
-        case 4: {
-            OptimizedCalculation calculatorOpt(P, N_MAX);
-            calculatorOpt.run();
-            if (rank == 0) cout << "✓ Variant 1.1 (Optimized) completed" << endl;
-            break;
-        }
-        case 5: {
+        case 5:
             // Run all variants
-            StandardCalculation calculator(P, N_MAX);
-            calculator.run();
-            if (rank == 0) cout << "✓ Variant 1 completed" << endl;
-
-            ScatterCalculation calculatorS(P, N_MAX);
-            calculatorS.run();
-            if (rank == 0) cout << "✓ Variant 2 completed" << endl;
-
-            AsyncCalculation calculatorA(P, N_MAX);
-            calculatorA.run();
-            if (rank == 0) cout << "✓ Variant 3 completed" << endl;
-
-            OptimizedCalculation calculatorOpt(P, N_MAX);
-            calculatorOpt.run();
-            if (rank == 0) cout << "✓ Variant 1.1 completed" << endl;
+            for (int variant: ALL_VARIANTS) {
+                runVariant(variant, P, N_MAX, masterWorks, threads, chunkSize, operandFiles, topology);
+                if (rank == 0) cout << "✓ " << variantName(variant) << " completed" << endl;
+            }
             break;
-        }
         case 6:
             // Verification only - do nothing
             break;
         default:
-            if (rank == 0) cout << "No variant executed for choice: " << choice << endl;
+            if (runVariant(choice, P, N_MAX, masterWorks, threads, chunkSize, operandFiles, topology)) {
+                if (rank == 0) cout << "✓ " << variantName(choice) << " completed" << endl;
+            } else if (rank == 0) {
+                cout << "No variant executed for choice: " << choice << endl;
+            }
     }
 
+    delete topology;
+    BufferPool::clear();
     MPI_Finalize();
 
     // Verify results (only process 0)
     if (rank == 0 && (choice == 5 || choice == 6)) {
         Verification::runAllVerifications();
     }
+    if (rank == 0 && choice == 11) {
+        Verification::printComparison("Subtraction", "resultSubtractSeq.txt", "resultSubtract.txt");
+    } else if (rank == 0 && choice == 12) {
+        Verification::printComparison("Comparison", "resultCompareSeq.txt", "resultCompare.txt");
+    } else if (rank == 0 && choice == 13) {
+        Verification::printComparison("Multiplication", "resultMultiplySeq.txt", "resultMultiply.txt");
+    } else if (rank == 0 && choice == 14) {
+        Verification::printComparison("Reduction", "resultReduceSeq.txt", "resultReduce.txt");
+    }
 
     return 0;
-}
\ No newline at end of file
+}
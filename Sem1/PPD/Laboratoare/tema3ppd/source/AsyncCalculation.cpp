@@ -1,171 +1,273 @@
 #include "../header/AsyncCalculation.h"
+#include <algorithm>
 #include <fstream>
 #include <mpi.h>
 #include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
 using namespace std;
 
+namespace {
+    // a result chunk followed by the carry out of its block, received as one message:
+    // the chunk lands in place in the result, the carry in its own slot
+    MPI_Datatype chunkWithCarry(BigNumber::Limb *chunk, const int length, BigNumber::Limb *carry) {
+        MPI_Aint addresses[2];
+        MPI_Get_address(chunk, &addresses[0]);
+        MPI_Get_address(carry, &addresses[1]);
+        const int lengths[2] = {length, 1};
+        MPI_Datatype type;
+        MPI_Type_create_hindexed(2, lengths, addresses, MPI_LIMB, &type);
+        MPI_Type_commit(&type);
+        return type;
+    }
+}
+
 void AsyncCalculation::run() {
     int rank;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     calculator(rank);
 }
 
+// Each block is streamed in chunks of chunkSize limbs through a ring of PIPELINE_DEPTH
+// buffers: workers add chunk i while chunk i + 1 is in flight and stream the partial
+// results back. Workers do not exchange carries: rank 0 resolves them while it writes
+// the chunks in order, using the carry out of every block (sent with its last chunk).
+// Both operands of a chunk travel in one message, the second right after the first.
+// With masterWorks rank 0 owns the first block and adds one chunk of it per round.
 void AsyncCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    const int firstWorker = masterWorks ? 0 : 1;
+    const int workers = P - firstWorker;
+    const int dimension = totalSize / workers;
     if (rank == 0) {
         ofstream outA("resultAsync.txt");
-        const int dimension = N_Max / (P - 1);
-        int extra = N_Max % (P - 1);
-        int startPoint = 0;
-        
-        // Arrays to keep track of send requests and data buffers
-        MPI_Request* sendRequests = new MPI_Request[(P - 1) * 2];
-        int** firstNumbers = new int*[P - 1];
-        int** secondNumbers = new int*[P - 1];
+        int extra = totalSize % workers;
 
-        // Send data to all processes asynchronously
-        for (int pid = 1; pid < P; pid++) {
+        // block of every worker, in limbs and in chunks
+        int *blockStart = BufferPool::acquire<int>(P);
+        int *blockSize = BufferPool::acquire<int>(P);
+        int *chunkCount = BufferPool::acquire<int>(P);
+        int *firstChunk = BufferPool::acquire<int>(P);
+        int startPoint = 0;
+        int totalChunks = 0;
+        int maxChunks = 0;
+        for (int pid = firstWorker; pid < P; pid++) {
             int endPoint = startPoint + dimension;
             if (extra > 0) {
                 endPoint++;
                 extra--;
             }
-            int batchSize = endPoint - startPoint;
-            
-            firstNumbers[pid - 1] = GenerateNumber::readNumberBlock("firstNumber.txt", startPoint, batchSize);
-            secondNumbers[pid - 1] = GenerateNumber::readNumberBlock("secondNumber.txt", startPoint, batchSize);
-            
-            MPI_Isend(firstNumbers[pid - 1], batchSize, MPI_INT, pid, 1, MPI_COMM_WORLD, &sendRequests[(pid - 1) * 2]);
-            MPI_Isend(secondNumbers[pid - 1], batchSize, MPI_INT, pid, 2, MPI_COMM_WORLD, &sendRequests[(pid - 1) * 2 + 1]);
-            
+            blockStart[pid] = startPoint;
+            blockSize[pid] = endPoint - startPoint;
+            // an empty block still sends one empty chunk, it carries the carry out of the block
+            chunkCount[pid] = max(1, (blockSize[pid] + chunkSize - 1) / chunkSize);
+            firstChunk[pid] = totalChunks;
+            totalChunks += chunkCount[pid];
+            if (chunkCount[pid] > maxChunks) {
+                maxChunks = chunkCount[pid];
+            }
             startPoint = endPoint;
         }
 
-        // Receive results from all processes asynchronously
-        extra = N_Max % (P - 1);
-        startPoint = 0;
-        MPI_Request* recvRequests = new MPI_Request[P - 1];
-        int** results = new int*[P - 1];
-        int* batchSizes = new int[P - 1];
-
+        // Post every result receive up front so workers never block on their result sends
+        BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+        BigNumber::Limb *blockCarries = BufferPool::acquire<BigNumber::Limb>(P);
+        MPI_Request *recvRequests = BufferPool::acquire<MPI_Request>(totalChunks);
         for (int pid = 1; pid < P; pid++) {
-            int endPoint = startPoint + dimension;
-            if (extra > 0) {
-                endPoint++;
-                extra--;
+            for (int c = 0; c < chunkCount[pid]; c++) {
+                const int offset = c * chunkSize;
+                const int length = min(chunkSize, blockSize[pid] - offset);
+                MPI_Request *request = &recvRequests[firstChunk[pid] + c];
+                if (c + 1 < chunkCount[pid]) {
+                    MPI_Irecv(result + blockStart[pid] + offset, length, MPI_LIMB, pid, 3, MPI_COMM_WORLD, request);
+                } else {
+                    MPI_Datatype last = chunkWithCarry(result + blockStart[pid] + offset, length, &blockCarries[pid]);
+                    MPI_Irecv(MPI_BOTTOM, 1, last, pid, 3, MPI_COMM_WORLD, request);
+                    MPI_Type_free(&last);
+                }
             }
-            batchSizes[pid - 1] = endPoint - startPoint;
-            results[pid - 1] = new int[batchSizes[pid - 1]];
-            
-            MPI_Irecv(results[pid - 1], batchSizes[pid - 1], MPI_INT, pid, 3, MPI_COMM_WORLD, &recvRequests[pid - 1]);
-            
-            startPoint = endPoint;
         }
 
-        // Wait for all receives to complete and write results
-        for (int pid = 1; pid < P; pid++) {
-            MPI_Wait(&recvRequests[pid - 1], MPI_STATUS_IGNORE);
-            for (int i = 0; i < batchSizes[pid - 1]; i++) {
-                outA << results[pid - 1][i] << " ";
+        // Chunks are written in order as soon as they arrive, carries are resolved on the way
+        int writePid = firstWorker;
+        int writeChunk = 0;
+        int ownComputed = 0;
+        BigNumber::Limb ownCarry = 0;
+        BigNumber::Limb carry = 0;
+        BigNumber::Limb topLimb = 0;
+        uint64_t checksum = 0;
+        auto writeArrived = [&](const bool wait) {
+            while (writePid < P) {
+                if (writePid == 0 && writeChunk < chunkCount[0]) {
+                    // master's own chunks are ready once computed
+                    if (writeChunk >= ownComputed) {
+                        return;
+                    }
+                } else if (writeChunk < chunkCount[writePid]) {
+                    MPI_Request *request = &recvRequests[firstChunk[writePid] + writeChunk];
+                    if (wait) {
+                        MPI_Wait(request, MPI_STATUS_IGNORE);
+                    } else {
+                        int arrived = 0;
+                        MPI_Test(request, &arrived, MPI_STATUS_IGNORE);
+                        if (!arrived) {
+                            return;
+                        }
+                    }
+                    Benchmark::lap(Benchmark::GATHER);
+                }
+                if (writeChunk < chunkCount[writePid]) {
+                    const int offset = blockStart[writePid] + writeChunk * chunkSize;
+                    const int length = min(chunkSize, blockStart[writePid] + blockSize[writePid] - offset);
+                    BigNumber::passCarry(result + offset, length, carry);
+                    if (Checksum::enabled) {
+                        checksum = Checksum::add(checksum, Checksum::hash(result + offset, length, offset));
+                    }
+                    Benchmark::lap(Benchmark::CARRY);
+                    BigNumber::writeDigits(outA, result + offset, length, N_Max - (long long) offset * BigNumber::DIGITS_PER_LIMB);
+                    Benchmark::lap(Benchmark::WRITE);
+                    if (length > 0) {
+                        topLimb = result[offset + length - 1];
+                    }
+                    writeChunk++;
+                } else {
+                    // the carry out of the block came with its last result chunk
+                    carry += writePid == 0 ? ownCarry : blockCarries[writePid];
+                    Benchmark::lap(Benchmark::CARRY);
+                    writePid++;
+                    writeChunk = 0;
+                }
             }
-            
-            // Get final carry from last process
-            if (pid == P - 1) {
-                int finalCarry;
-                MPI_Recv(&finalCarry, 1, MPI_INT, pid, 4, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                if (finalCarry != 0) {
-                    outA << finalCarry;
+        };
+
+        // Send data to all processes asynchronously, one chunk per worker per round
+        // a slot holds both operands of a chunk, the second right after the first
+        const int slotSize = 2 * chunkSize;
+        MPI_Request *sendRequests = BufferPool::acquire<MPI_Request>(P * PIPELINE_DEPTH);
+        BigNumber::Limb *operandSlots = BufferPool::acquire<BigNumber::Limb>((long long) P * PIPELINE_DEPTH * slotSize);
+        for (int i = 0; i < P * PIPELINE_DEPTH; i++) {
+            sendRequests[i] = MPI_REQUEST_NULL;
+        }
+        for (int c = 0; c < maxChunks; c++) {
+            for (int pid = 1; pid < P; pid++) {
+                if (c >= chunkCount[pid]) {
+                    continue;
                 }
+                const int slot = c % PIPELINE_DEPTH;
+                MPI_Request *request = &sendRequests[pid * PIPELINE_DEPTH + slot];
+                MPI_Wait(request, MPI_STATUS_IGNORE);
+                Benchmark::lap(Benchmark::DISTRIBUTE);
+
+                const int offset = c * chunkSize;
+                const int length = min(chunkSize, blockSize[pid] - offset);
+                BigNumber::Limb *operands = operandSlots + (long long) (pid * PIPELINE_DEPTH + slot) * slotSize;
+                GenerateNumber::readNumberBlock("firstNumber.bin", blockStart[pid] + offset, length, operands);
+                GenerateNumber::readNumberBlock("secondNumber.bin", blockStart[pid] + offset, length, operands + length);
+                Benchmark::lap(Benchmark::READ);
+
+                MPI_Isend(operands, 2 * length, MPI_LIMB, pid, 1, MPI_COMM_WORLD, request);
+                Benchmark::lap(Benchmark::DISTRIBUTE);
             }
-            delete[] results[pid - 1];
+            if (masterWorks && c < chunkCount[0]) {
+                // master-ul aduna o bucata din primul bloc cat timp bucatile trimise sunt in drum
+                const int offset = c * chunkSize;
+                const int length = min(chunkSize, blockSize[0] - offset);
+                // slot-urile procesului 0 nu sunt folosite la trimitere
+                GenerateNumber::readNumberBlock("firstNumber.bin", offset, length, operandSlots);
+                GenerateNumber::readNumberBlock("secondNumber.bin", offset, length, operandSlots + length);
+                Benchmark::lap(Benchmark::READ);
+                ownCarry = BigNumber::sum(operandSlots, operandSlots + length, result + offset, length, ownCarry);
+                ownComputed++;
+                Benchmark::lap(Benchmark::COMPUTE);
+            }
+            writeArrived(false);
+        }
+        writeArrived(true);
+
+        if (Checksum::enabled) {
+            Checksum::write("resultAsync.txt", Checksum::add(checksum, Checksum::hash(&carry, 1, totalSize)));
+        }
+
+        // Get final carry from last process
+        const BigNumber::Limb finalCarry = BigNumber::overflowDigit(topLimb, N_Max, carry);
+        if (finalCarry != 0) {
+            outA << finalCarry;
         }
 
         // Wait for all sends to complete before freeing memory
-        MPI_Waitall((P - 1) * 2, sendRequests, MPI_STATUSES_IGNORE);
-        
+        MPI_Waitall(P * PIPELINE_DEPTH, sendRequests, MPI_STATUSES_IGNORE);
+        Benchmark::lap(Benchmark::DISTRIBUTE);
+
         // Clean up
-        for (int i = 0; i < P - 1; i++) {
-            delete[] firstNumbers[i];
-            delete[] secondNumbers[i];
-        }
-        delete[] firstNumbers;
-        delete[] secondNumbers;
-        delete[] sendRequests;
-        delete[] recvRequests;
-        delete[] results;
-        delete[] batchSizes;
+        BufferPool::release(operandSlots);
+        BufferPool::release(sendRequests);
+        BufferPool::release(recvRequests);
+        BufferPool::release(result);
+        BufferPool::release(blockCarries);
+        BufferPool::release(blockStart);
+        BufferPool::release(blockSize);
+        BufferPool::release(chunkCount);
+        BufferPool::release(firstChunk);
         outA.close();
     }
     else {
-        // worker primese numerele de la master
-        MPI_Request requests[2];
-        const int dimension = N_Max / (P - 1);
-        const int extra = N_Max % (P - 1);
-        const int batchSize = dimension + ((rank - 1) < extra);
-
-        int *firstNumber = new int[batchSize];
-        int *secondNumber = new int[batchSize];
-        int* result = new int[batchSize];
-        
-        // worker primese numerele de la master
-        MPI_Irecv(firstNumber, batchSize, MPI_INT, 0, 1, MPI_COMM_WORLD, &requests[0]);
-        MPI_Irecv(secondNumber, batchSize, MPI_INT, 0, 2, MPI_COMM_WORLD, &requests[1]);
-
-        // worker asteapta sa primeasca ambele numere inainte de a calcula suma
-        MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
-
-        // worker calculeaza suma portiunii sale
-        int carry = sum(firstNumber, secondNumber, result, batchSize);
-
-        // worker primeste carry de la procesul anterior
-        if (rank > 1) {
-            int receivedCarry = 0;
-            MPI_Request carryRecvRequest;
-            MPI_Irecv(&receivedCarry, 1, MPI_INT, rank - 1, 5, MPI_COMM_WORLD, &carryRecvRequest);
-            MPI_Wait(&carryRecvRequest, MPI_STATUS_IGNORE);
-            
-            if (receivedCarry > 0) {
-                passCarry(result, batchSize, receivedCarry);
-                carry += receivedCarry;
-            }
-        }
-        
-        // worker trimite carry la procesul urmator
-        if (rank < (P - 1)) {
-            MPI_Request carrySendRequest;
-            MPI_Isend(&carry, 1, MPI_INT, rank + 1, 5, MPI_COMM_WORLD, &carrySendRequest);
-            MPI_Wait(&carrySendRequest, MPI_STATUS_IGNORE);
+        const int extra = totalSize % workers;
+        const int batchSize = dimension + ((rank - firstWorker) < extra);
+        const int chunks = max(1, (batchSize + chunkSize - 1) / chunkSize);
+
+        // both operands of a chunk per slot; a result slot has room for the carry after the chunk
+        BigNumber::Limb *operands = BufferPool::acquire<BigNumber::Limb>(PIPELINE_DEPTH * 2 * chunkSize);
+        BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(PIPELINE_DEPTH * (chunkSize + 1));
+        MPI_Request recvRequests[PIPELINE_DEPTH];
+        MPI_Request resultRequests[PIPELINE_DEPTH];
+        for (int slot = 0; slot < PIPELINE_DEPTH; slot++) {
+            resultRequests[slot] = MPI_REQUEST_NULL;
         }
 
-        // worker trimite rezultatul la master
-        MPI_Request resultRequest;
-        MPI_Isend(result, batchSize, MPI_INT, 0, 3, MPI_COMM_WORLD, &resultRequest);
-        MPI_Wait(&resultRequest, MPI_STATUS_IGNORE);
-        
-        // Last process sends final carry la master
-        if (rank == P - 1) {
-            MPI_Send(&carry, 1, MPI_INT, 0, 4, MPI_COMM_WORLD);
+        // worker primeste primele bucati de la master
+        for (int c = 0; c < chunks && c < PIPELINE_DEPTH; c++) {
+            const int length = min(chunkSize, batchSize - c * chunkSize);
+            MPI_Irecv(operands + c * 2 * chunkSize, 2 * length, MPI_LIMB, 0, 1, MPI_COMM_WORLD, &recvRequests[c]);
         }
 
-        delete[] firstNumber;
-        delete[] secondNumber;
-        delete[] result;
-    }
-}
+        BigNumber::Limb carry = 0;
+        for (int c = 0; c < chunks; c++) {
+            const int slot = c % PIPELINE_DEPTH;
+            const int length = min(chunkSize, batchSize - c * chunkSize);
+            BigNumber::Limb *first = operands + slot * 2 * chunkSize;
+            BigNumber::Limb *second = first + length;
+            BigNumber::Limb *partial = result + slot * (chunkSize + 1);
 
-int AsyncCalculation::sum(const int *firstNumber, const int *secondNumber, int *result, const int size) {
-    int carry = 0;
-    for (int i = 0; i < size; i++) {
-        result[i] = (firstNumber[i] + secondNumber[i] + carry) % 10;
-        carry = (firstNumber[i] + secondNumber[i] + carry) / 10;
-    }
-    return carry;
-}
+            // worker asteapta bucata curenta, urmatoarele sunt deja in drum
+            MPI_Wait(&recvRequests[slot], MPI_STATUS_IGNORE);
+            MPI_Wait(&resultRequests[slot], MPI_STATUS_IGNORE);
+            Benchmark::lap(Benchmark::DISTRIBUTE);
+
+            // worker calculeaza suma bucatii, carry-ul intre bucati ramane local
+            carry = BigNumber::sum(first, second, partial, length, carry);
+            Benchmark::lap(Benchmark::COMPUTE);
+            // ultima bucata duce si carry-ul blocului
+            const bool last = c == chunks - 1;
+            if (last) {
+                partial[length] = carry;
+                Benchmark::lap(Benchmark::CARRY);
+            }
+            MPI_Isend(partial, length + last, MPI_LIMB, 0, 3, MPI_COMM_WORLD, &resultRequests[slot]);
+            Benchmark::lap(Benchmark::GATHER);
 
-void AsyncCalculation::passCarry(int *number, const int size, int &carry) {
-    for (int i = 0; i < size; i++) {
-        const int value = number[i] + carry;
-        number[i] = value % 10;
-        carry = value / 10;
+            const int next = c + PIPELINE_DEPTH;
+            if (next < chunks) {
+                const int nextLength = min(chunkSize, batchSize - next * chunkSize);
+                MPI_Irecv(first, 2 * nextLength, MPI_LIMB, 0, 1, MPI_COMM_WORLD, &recvRequests[slot]);
+            }
+        }
+
+        MPI_Waitall(PIPELINE_DEPTH, resultRequests, MPI_STATUSES_IGNORE);
+        Benchmark::lap(Benchmark::GATHER);
+
+        BufferPool::release(operands);
+        BufferPool::release(result);
     }
 }
-
@@ -0,0 +1,171 @@
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include <mpi.h>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    double phaseTimes[Benchmark::PHASES];
+    double lastLap = 0;
+    // in flight, waited
+    double overlapTimes[2];
+    bool insideMeasure = false;
+
+    bool endsWith(const string &text, const string &suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+const char *Benchmark::PHASE_NAMES[Benchmark::PHASES] = {
+    "read", "distribute", "compute", "carry", "gather", "write"
+};
+
+void Benchmark::start() {
+    for (double &time: phaseTimes) {
+        time = 0;
+    }
+    overlapTimes[0] = 0;
+    overlapTimes[1] = 0;
+    lastLap = MPI_Wtime();
+}
+
+void Benchmark::lap(const Phase phase) {
+    const double now = MPI_Wtime();
+    phaseTimes[phase] += now - lastLap;
+    lastLap = now;
+}
+
+void Benchmark::overlap(const double inFlight, const double waited) {
+    overlapTimes[0] += inFlight;
+    overlapTimes[1] += waited;
+}
+
+bool Benchmark::measuring() {
+    return insideMeasure;
+}
+
+Benchmark::Measurement Benchmark::measure(const string &variant, const int P, const long long N_Max, const int warmup,
+                                          const int repetitions, const function<void()> &calculation) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    insideMeasure = true;
+    for (int i = 0; i < warmup; i++) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        calculation();
+    }
+
+    Measurement measurement;
+    measurement.variant = variant;
+    measurement.processes = P;
+    measurement.digits = N_Max;
+    measurement.repetitions = repetitions;
+    vector<double> totals;
+    // after the warm-up the pool already holds every buffer a run needs
+    const long long allocationsBefore = BufferPool::allocations();
+    for (int i = 0; i < repetitions; i++) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        start();
+        const double begin = MPI_Wtime();
+        calculation();
+        MPI_Barrier(MPI_COMM_WORLD);
+        totals.push_back(MPI_Wtime() - begin);
+
+        // fiecare faza dureaza cat la cel mai lent proces
+        double slowest[PHASES];
+        MPI_Reduce(phaseTimes, slowest, PHASES, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        for (int phase = 0; phase < PHASES; phase++) {
+            measurement.phases[phase] += slowest[phase] / repetitions;
+        }
+        // overlap is averaged over the processes
+        double overlapSum[2];
+        MPI_Reduce(overlapTimes, overlapSum, 2, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        measurement.inFlight += overlapSum[0] / P / repetitions;
+        measurement.hidden += (overlapSum[0] - overlapSum[1]) / P / repetitions;
+    }
+    insideMeasure = false;
+
+    const long long allocations = BufferPool::allocations() - allocationsBefore;
+    MPI_Reduce(&allocations, &measurement.allocations, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (repetitions > 0) {
+        measurement.min = totals[0];
+        measurement.max = totals[0];
+        for (double total: totals) {
+            measurement.mean += total / repetitions;
+            measurement.min = total < measurement.min ? total : measurement.min;
+            measurement.max = total > measurement.max ? total : measurement.max;
+        }
+        double variance = 0;
+        for (double total: totals) {
+            variance += (total - measurement.mean) * (total - measurement.mean) / repetitions;
+        }
+        measurement.stddev = sqrt(variance);
+    }
+    return measurement;
+}
+
+void Benchmark::compare(Measurement &measurement, const double sequentialMean) {
+    measurement.speedup = measurement.mean > 0 ? sequentialMean / measurement.mean : 0;
+    measurement.efficiency = measurement.processes > 0 ? measurement.speedup / measurement.processes : 0;
+}
+
+void Benchmark::report(const string &reportFile, const Measurement &measurement) {
+    const bool json = endsWith(reportFile, ".json");
+    const bool exists = ifstream(reportFile).good();
+    ofstream out(reportFile, ios::app);
+    if (!out) {
+        cerr << "Report file could not be opened" << endl;
+        return;
+    }
+    out << setprecision(9);
+    if (json) {
+        out << "{\"variant\": \"" << measurement.variant << "\", \"processes\": " << measurement.processes
+            << ", \"digits\": " << measurement.digits << ", \"profile\": \"" << measurement.profile
+            << "\", \"repetitions\": " << measurement.repetitions
+            << ", \"mean\": " << measurement.mean << ", \"min\": " << measurement.min
+            << ", \"max\": " << measurement.max << ", \"stddev\": " << measurement.stddev;
+        for (int phase = 0; phase < PHASES; phase++) {
+            out << ", \"" << PHASE_NAMES[phase] << "\": " << measurement.phases[phase];
+        }
+        out << ", \"in_flight\": " << measurement.inFlight << ", \"hidden\": " << measurement.hidden;
+        out << ", \"speedup\": " << measurement.speedup << ", \"efficiency\": " << measurement.efficiency << "}\n";
+        return;
+    }
+    if (!exists) {
+        out << "variant,processes,digits,profile,repetitions,mean,min,max,stddev";
+        for (const char *name: PHASE_NAMES) {
+            out << "," << name;
+        }
+        out << ",in_flight,hidden,speedup,efficiency\n";
+    }
+    out << measurement.variant << "," << measurement.processes << "," << measurement.digits << ","
+        << measurement.profile << "," << measurement.repetitions << "," << measurement.mean << "," << measurement.min << ","
+        << measurement.max << "," << measurement.stddev;
+    for (double time: measurement.phases) {
+        out << "," << time;
+    }
+    out << "," << measurement.inFlight << "," << measurement.hidden;
+    out << "," << measurement.speedup << "," << measurement.efficiency << "\n";
+}
+
+void Benchmark::print(const Measurement &measurement) {
+    cout << fixed << setprecision(6);
+    cout << measurement.variant << ": mean " << measurement.mean << "s (min " << measurement.min
+         << ", max " << measurement.max << ", stddev " << measurement.stddev << ")";
+    cout << " speedup " << setprecision(2) << measurement.speedup << " efficiency " << measurement.efficiency << endl;
+    cout << setprecision(6);
+    for (int phase = 0; phase < PHASES; phase++) {
+        cout << "    " << PHASE_NAMES[phase] << " " << measurement.phases[phase] << "s" << endl;
+    }
+    cout << "    pool allocations " << measurement.allocations << endl;
+    if (measurement.inFlight > 0) {
+        cout << "    hidden communication " << measurement.hidden << "s of " << measurement.inFlight << "s in flight ("
+             << setprecision(1) << 100 * measurement.hidden / measurement.inFlight << "%)" << endl;
+    }
+    cout << defaultfloat;
+}
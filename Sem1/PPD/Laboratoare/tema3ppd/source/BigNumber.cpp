@@ -0,0 +1,420 @@
+#include "../header/BigNumber.h"
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <utility>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BIGNUMBER_X86_KERNELS
+#endif
+using namespace std;
+
+namespace {
+    const BigNumber::Limb POWERS_OF_TEN[BigNumber::DIGITS_PER_LIMB] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+
+    typedef BigNumber::Limb (*SumKernel)(const BigNumber::Limb *, const BigNumber::Limb *, BigNumber::Limb *,
+                                         long long, BigNumber::Limb);
+
+    BigNumber::Limb sumScalar(const BigNumber::Limb *first, const BigNumber::Limb *second, BigNumber::Limb *result,
+                              const long long size, BigNumber::Limb carry) {
+        for (long long i = 0; i < size; i++) {
+            // 2 * (10^9 - 1) + 1 still fits in 32 bits
+            const BigNumber::Limb value = first[i] + second[i] + carry;
+            carry = value >= BigNumber::BASE;
+            result[i] = carry ? value - BigNumber::BASE : value;
+        }
+        return carry;
+    }
+
+#ifdef BIGNUMBER_X86_KERNELS
+    // Vector kernels: the limbs of a vector are added without carries, then
+    //   generate  = sum >= BASE      (lane produces a carry on its own)
+    //   propagate = sum == BASE - 1  (lane forwards an incoming carry)
+    // as bit masks. Lane i receives a carry iff bit i of ((generate << 1 | carry) + propagate) ^ propagate
+    // is set: the integer addition ripples the carries through the runs of propagate lanes,
+    // and the bit past the last lane is the carry out of the vector.
+    // Sums stay below 2^31, so the signed compares are exact.
+
+    __attribute__((target("avx2")))
+    BigNumber::Limb sumAvx2(const BigNumber::Limb *first, const BigNumber::Limb *second, BigNumber::Limb *result,
+                            const long long size, BigNumber::Limb carry) {
+        const __m256i base = _mm256_set1_epi32((int) BigNumber::BASE);
+        const __m256i maxLimb = _mm256_set1_epi32((int) BigNumber::BASE - 1);
+        const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        long long i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m256i sum = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *) (first + i)),
+                                                 _mm256_loadu_si256((const __m256i *) (second + i)));
+            const unsigned generate = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sum, maxLimb)));
+            const unsigned propagate = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, maxLimb)));
+            const unsigned ripple = ((generate << 1) | carry) + propagate;
+            const unsigned carries = (ripple ^ propagate) & 0xFF;
+            carry = ripple >> 8;
+
+            const __m256i carryLanes = _mm256_srli_epi32(
+                _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int) carries), laneBits), laneBits), 31);
+            const __m256i value = _mm256_add_epi32(sum, carryLanes);
+            const __m256i overflow = _mm256_cmpgt_epi32(value, maxLimb);
+            _mm256_storeu_si256((__m256i *) (result + i), _mm256_sub_epi32(value, _mm256_and_si256(overflow, base)));
+        }
+        return sumScalar(first + i, second + i, result + i, size - i, carry);
+    }
+
+    BigNumber::Limb sumSse2(const BigNumber::Limb *first, const BigNumber::Limb *second, BigNumber::Limb *result,
+                            const long long size, BigNumber::Limb carry) {
+        const __m128i base = _mm_set1_epi32((int) BigNumber::BASE);
+        const __m128i maxLimb = _mm_set1_epi32((int) BigNumber::BASE - 1);
+        const __m128i laneBits = _mm_setr_epi32(1, 2, 4, 8);
+        long long i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128i sum = _mm_add_epi32(_mm_loadu_si128((const __m128i *) (first + i)),
+                                              _mm_loadu_si128((const __m128i *) (second + i)));
+            const unsigned generate = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(sum, maxLimb)));
+            const unsigned propagate = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(sum, maxLimb)));
+            const unsigned ripple = ((generate << 1) | carry) + propagate;
+            const unsigned carries = (ripple ^ propagate) & 0xF;
+            carry = ripple >> 4;
+
+            const __m128i carryLanes = _mm_srli_epi32(
+                _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int) carries), laneBits), laneBits), 31);
+            const __m128i value = _mm_add_epi32(sum, carryLanes);
+            const __m128i overflow = _mm_cmpgt_epi32(value, maxLimb);
+            _mm_storeu_si128((__m128i *) (result + i), _mm_sub_epi32(value, _mm_and_si128(overflow, base)));
+        }
+        return sumScalar(first + i, second + i, result + i, size - i, carry);
+    }
+#endif
+
+    // picked once from the CPU the program runs on, BIGNUMBER_KERNEL=sse2|scalar forces a slower one
+    SumKernel selectKernel(const char **name) {
+        const char *forced = getenv("BIGNUMBER_KERNEL");
+        const string wanted = forced != nullptr ? forced : "";
+#ifdef BIGNUMBER_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && (wanted.empty() || wanted == "avx2")) {
+            *name = "avx2";
+            return sumAvx2;
+        }
+        if (__builtin_cpu_supports("sse2") && wanted != "scalar") {
+            *name = "sse2";
+            return sumSse2;
+        }
+#endif
+        *name = "scalar";
+        return sumScalar;
+    }
+
+    // count digits of limb and a space after each, no data dependent branches
+    inline void formatLimb(BigNumber::Limb limb, const int count, char *buffer) {
+        for (int j = 0; j < count; j++) {
+            const BigNumber::Limb next = limb / 10;
+            buffer[2 * j] = (char) ('0' + (limb - 10 * next));
+            buffer[2 * j + 1] = ' ';
+            limb = next;
+        }
+    }
+
+    const char *kernelName = nullptr;
+    const SumKernel sumKernel = selectKernel(&kernelName);
+
+    // result (firstSize + secondSize limbs) = first * second, O(firstSize * secondSize);
+    // a limb product (< 10^18) plus two limbs still fits in 64 bits
+    void multiplySchoolbook(const BigNumber::Limb *first, const long long firstSize, const BigNumber::Limb *second,
+                            const long long secondSize, BigNumber::Limb *result) {
+        for (long long i = 0; i < firstSize + secondSize; i++) {
+            result[i] = 0;
+        }
+        for (long long i = 0; i < firstSize; i++) {
+            uint64_t carry = 0;
+            for (long long j = 0; j < secondSize; j++) {
+                const uint64_t value = result[i + j] + (uint64_t) first[i] * second[j] + carry;
+                result[i + j] = (BigNumber::Limb) (value % BigNumber::BASE);
+                carry = value / BigNumber::BASE;
+            }
+            result[i + secondSize] = (BigNumber::Limb) carry;
+        }
+    }
+
+    // result (2 * size limbs) = first * second, both of size limbs:
+    // (a1 B + a0)(b1 B + b0) = z2 B^2 + ((a0 + a1)(b0 + b1) - z2 - z0) B + z0
+    void multiplyKaratsuba(const BigNumber::Limb *first, const BigNumber::Limb *second, const long long size,
+                           BigNumber::Limb *result) {
+        if (size < BigNumber::KARATSUBA_THRESHOLD) {
+            multiplySchoolbook(first, size, second, size, result);
+            return;
+        }
+        const long long low = size / 2;
+        const long long high = size - low;
+        multiplyKaratsuba(first, second, low, result);
+        multiplyKaratsuba(first + low, second + low, high, result + 2 * low);
+
+        vector<BigNumber::Limb> firstSum(high + 1);
+        vector<BigNumber::Limb> secondSum(high + 1);
+        BigNumber::sum(first + low, high, first, low, firstSum.data(), high + 1);
+        BigNumber::sum(second + low, high, second, low, secondSum.data(), high + 1);
+        vector<BigNumber::Limb> middle(2 * high + 2);
+        multiplyKaratsuba(firstSum.data(), secondSum.data(), high + 1, middle.data());
+
+        BigNumber::Limb borrow = BigNumber::subtract(middle.data(), result, middle.data(), 2 * low);
+        BigNumber::passBorrow(middle.data() + 2 * low, 2 * high + 2 - 2 * low, borrow);
+        borrow = BigNumber::subtract(middle.data(), result + 2 * low, middle.data(), 2 * high);
+        BigNumber::passBorrow(middle.data() + 2 * high, 2, borrow);
+
+        // the middle term fits below result[2 * size], the final carry is always 0
+        BigNumber::Limb carry = BigNumber::sum(result + low, middle.data(), result + low, 2 * high + 2);
+        BigNumber::passCarry(result + low + 2 * high + 2, size - high - 2, carry);
+    }
+}
+
+int BigNumber::digit(const long long index) const {
+    const Limb limb = limbs[index / DIGITS_PER_LIMB];
+    return (int) (limb / POWERS_OF_TEN[index % DIGITS_PER_LIMB] % 10);
+}
+
+void BigNumber::resize(const long long numberOfDigits) {
+    limbs.resize(limbCount(numberOfDigits), 0);
+    this->numberOfDigits = numberOfDigits;
+}
+
+BigNumber::Limb BigNumber::sum(const Limb *first, const Limb *second, Limb *result, const long long size, Limb carry) {
+    return sumKernel(first, second, result, size, carry);
+}
+
+const char *BigNumber::sumKernelName() {
+    return kernelName;
+}
+
+BigNumber::Limb BigNumber::sum(const Limb *first, long long firstSize, const Limb *second, long long secondSize,
+                               Limb *result, const long long size) {
+    if (firstSize < secondSize) {
+        swap(first, second);
+        swap(firstSize, secondSize);
+    }
+    if (firstSize > size) {
+        firstSize = size;
+    }
+    if (secondSize > firstSize) {
+        secondSize = firstSize;
+    }
+    Limb carry = sum(first, second, result, secondSize);
+    for (long long i = secondSize; i < firstSize; i++) {
+        result[i] = first[i];
+    }
+    passCarry(result + secondSize, firstSize - secondSize, carry);
+    for (long long i = firstSize; i < size; i++) {
+        result[i] = carry;
+        carry = 0;
+    }
+    return carry;
+}
+
+void BigNumber::passCarry(Limb *number, const long long size, Limb &carry) {
+    for (long long i = 0; i < size && carry != 0; i++) {
+        const Limb value = number[i] + carry;
+        carry = value >= BASE;
+        number[i] = carry ? value - BASE : value;
+    }
+}
+
+BigNumber::Limb BigNumber::subtract(const Limb *first, const Limb *second, Limb *result, const long long size,
+                                    Limb borrow) {
+    for (long long i = 0; i < size; i++) {
+        const Limb subtrahend = second[i] + borrow;
+        borrow = first[i] < subtrahend;
+        result[i] = borrow ? first[i] + (BASE - subtrahend) : first[i] - subtrahend;
+    }
+    return borrow;
+}
+
+void BigNumber::passBorrow(Limb *number, const long long size, Limb &borrow) {
+    for (long long i = 0; i < size && borrow != 0; i++) {
+        borrow = number[i] == 0;
+        number[i] = borrow ? BASE - 1 : number[i] - 1;
+    }
+}
+
+long long BigNumber::borrowRun(const Limb *number, const long long size) {
+    long long run = 0;
+    while (run < size && number[run] == 0) {
+        run++;
+    }
+    return run;
+}
+
+void BigNumber::selectBorrow(Limb *number, const long long size, const long long run) {
+    for (long long i = 0; i < run; i++) {
+        number[i] = BASE - 1;
+    }
+    if (run < size) {
+        number[run]--;
+    }
+}
+
+long long BigNumber::topDifference(const Limb *first, const Limb *second, const long long size, int &order) {
+    for (long long i = size - 1; i >= 0; i--) {
+        if (first[i] != second[i]) {
+            order = first[i] < second[i] ? -1 : 1;
+            return i;
+        }
+    }
+    order = 0;
+    return -1;
+}
+
+int BigNumber::compare(const Limb *first, const Limb *second, const long long size) {
+    int order;
+    topDifference(first, second, size, order);
+    return order;
+}
+
+void BigNumber::multiply(const Limb *first, const long long firstSize, const Limb *second, const long long secondSize,
+                         Limb *result) {
+    if (firstSize < secondSize) {
+        swap(first, second);
+    }
+    const long long longSize = max(firstSize, secondSize);
+    const long long shortSize = min(firstSize, secondSize);
+    if (shortSize < KARATSUBA_THRESHOLD) {
+        multiplySchoolbook(first, longSize, second, shortSize, result);
+        return;
+    }
+    // the longer operand is cut in pieces of shortSize limbs, every piece is a balanced Karatsuba product
+    for (long long i = 0; i < longSize + shortSize; i++) {
+        result[i] = 0;
+    }
+    vector<Limb> piece(shortSize);
+    vector<Limb> product(2 * shortSize);
+    for (long long offset = 0; offset < longSize; offset += shortSize) {
+        const long long length = min(shortSize, longSize - offset);
+        for (long long i = 0; i < shortSize; i++) {
+            piece[i] = i < length ? first[offset + i] : 0;
+        }
+        multiplyKaratsuba(piece.data(), second, shortSize, product.data());
+        const long long used = length + shortSize;
+        Limb carry = sum(result + offset, product.data(), result + offset, used);
+        passCarry(result + offset + used, longSize + shortSize - offset - used, carry);
+    }
+}
+
+long long BigNumber::carryRun(const Limb *number, const long long size) {
+    long long run = 0;
+    while (run < size && number[run] == BASE - 1) {
+        run++;
+    }
+    return run;
+}
+
+void BigNumber::selectCarry(Limb *number, const long long size, const long long run) {
+    for (long long i = 0; i < run; i++) {
+        number[i] = 0;
+    }
+    if (run < size) {
+        number[run]++;
+    }
+}
+
+void BigNumber::accumulate(Accumulator *accumulator, const Limb *number, const long long size) {
+    // no carries between words, the compiler vectorizes this loop
+    for (long long i = 0; i < size; i++) {
+        accumulator[i] += number[i];
+    }
+}
+
+BigNumber::Accumulator BigNumber::normalize(const Accumulator *accumulator, const long long size, Limb *result) {
+    Accumulator carry = 0;
+    for (long long i = 0; i < size; i++) {
+        // accumulator[i] + carry stays below 2^64 as long as accumulator[i] does not come close to it
+        const Accumulator value = accumulator[i] + carry;
+        result[i] = (Limb) (value % BASE);
+        carry = value / BASE;
+    }
+    return carry;
+}
+
+void BigNumber::packDigits(const uint8_t *digits, const long long count, Limb *number, const long long size) {
+    for (long long i = 0; i < size; i++) {
+        const long long first = i * DIGITS_PER_LIMB;
+        long long last = first + DIGITS_PER_LIMB;
+        if (last > count) {
+            last = count;
+        }
+        Limb limb = 0;
+        for (long long j = last - 1; j >= first; j--) {
+            limb = limb * 10 + digits[j];
+        }
+        number[i] = limb;
+    }
+}
+
+void BigNumber::unpackDigits(const Limb *number, const long long count, uint8_t *digits) {
+    for (long long i = 0; i < count; i += DIGITS_PER_LIMB) {
+        Limb limb = number[i / DIGITS_PER_LIMB];
+        for (long long j = i; j < i + DIGITS_PER_LIMB && j < count; j++) {
+            digits[j] = limb % 10;
+            limb /= 10;
+        }
+    }
+}
+
+void BigNumber::writeDigits(ostream &out, const Limb *number, const long long size, const long long numberOfDigits) {
+    char buffer[2 * WRITE_CHUNK_DIGITS];
+    // chunks hold whole limbs, so each one starts at a limb boundary
+    for (long long digit = 0; digit < numberOfDigits && digit / DIGITS_PER_LIMB < size; digit += WRITE_CHUNK_DIGITS) {
+        const long long offset = digit / DIGITS_PER_LIMB;
+        const long long count = min<long long>(WRITE_CHUNK_DIGITS, numberOfDigits - digit);
+        out.write(buffer, formatDigits(number + offset, size - offset, count, buffer));
+    }
+}
+
+long long BigNumber::formatDigits(const Limb *number, const long long size, const long long numberOfDigits,
+                                  char *buffer) {
+    const long long fullLimbs = min(size, numberOfDigits / DIGITS_PER_LIMB);
+    for (long long i = 0; i < fullLimbs; i++) {
+        formatLimb(number[i], DIGITS_PER_LIMB, buffer + 2 * DIGITS_PER_LIMB * i);
+    }
+    long long length = 2 * DIGITS_PER_LIMB * fullLimbs;
+    if (fullLimbs < size) {
+        const int remaining = (int) (numberOfDigits - DIGITS_PER_LIMB * fullLimbs);
+        formatLimb(number[fullLimbs], remaining, buffer + length);
+        length += 2 * remaining;
+    }
+    return length;
+}
+
+long long BigNumber::parseDigits(const char *text, const long long length, uint8_t *digits) {
+    long long count = 0;
+    long long i = 0;
+    while (i < length) {
+#ifdef BIGNUMBER_X86_KERNELS
+        // 8 "d " pairs at once; anything else (line breaks, a count line, a sign) takes the scalar step
+        if (i + 16 <= length) {
+            const __m128i chunk = _mm_loadu_si128((const __m128i *) (text + i));
+            const __m128i values = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+            const int isDigit = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(values, _mm_set1_epi8(9)), values));
+            const int isSpace = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+            if ((isDigit & 0x5555) == 0x5555 && (isSpace & 0xAAAA) == 0xAAAA) {
+                const __m128i even = _mm_and_si128(values, _mm_set1_epi16(0x00FF));
+                _mm_storel_epi64((__m128i *) (digits + count), _mm_packus_epi16(even, even));
+                count += 8;
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        const char c = text[i++];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != '\v' && c != '\f') {
+            digits[count++] = (uint8_t) (c - '0');
+        }
+    }
+    return count;
+}
+
+BigNumber::Limb BigNumber::overflowDigit(const Limb topLimb, const long long numberOfDigits, const Limb carry) {
+    const int used = numberOfDigits % DIGITS_PER_LIMB;
+    if (used == 0) {
+        return carry;
+    }
+    return topLimb / POWERS_OF_TEN[used];
+}
@@ -0,0 +1,65 @@
+#include "../header/BufferPool.h"
+#include <mpi.h>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    struct Buffer {
+        void *memory;
+        size_t capacity;
+        bool used;
+    };
+
+    // a run needs a handful of buffers, a linear search is enough
+    vector<Buffer> buffers;
+    long long allocationCount = 0;
+}
+
+void *BufferPool::acquireBytes(const size_t bytes) {
+    Buffer *best = nullptr;
+    for (Buffer &buffer: buffers) {
+        if (!buffer.used && buffer.capacity >= bytes && (best == nullptr || buffer.capacity < best->capacity)) {
+            best = &buffer;
+        }
+    }
+    if (best != nullptr) {
+        best->used = true;
+        return best->memory;
+    }
+
+    void *memory = nullptr;
+    if (MPI_Alloc_mem((MPI_Aint) bytes, MPI_INFO_NULL, &memory) != MPI_SUCCESS) {
+        cerr << "Buffer could not be allocated" << endl;
+        throw bad_alloc();
+    }
+    allocationCount++;
+    buffers.push_back({memory, bytes, true});
+    return memory;
+}
+
+void BufferPool::release(void *buffer) {
+    if (buffer == nullptr) {
+        return;
+    }
+    for (Buffer &pooled: buffers) {
+        if (pooled.memory == buffer) {
+            pooled.used = false;
+            return;
+        }
+    }
+    cerr << "Buffer does not belong to the pool" << endl;
+}
+
+void BufferPool::clear() {
+    for (Buffer &buffer: buffers) {
+        MPI_Free_mem(buffer.memory);
+    }
+    buffers.clear();
+}
+
+long long BufferPool::allocations() {
+    return allocationCount;
+}
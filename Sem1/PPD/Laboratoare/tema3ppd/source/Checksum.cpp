@@ -0,0 +1,96 @@
+#include "../header/Checksum.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+bool Checksum::enabled = false;
+
+namespace {
+    const uint64_t MODULUS = (1ULL << 61) - 1;
+    // fixed random evaluation point
+    const uint64_t RADIX = 0x1d8e4e27c47d124fULL % MODULUS;
+
+    uint64_t multiply(const uint64_t first, const uint64_t second) {
+        const unsigned __int128 product = (unsigned __int128) first * second;
+        // 2^61 == 1 (mod 2^61 - 1)
+        uint64_t value = (uint64_t) (product & MODULUS) + (uint64_t) (product >> 61);
+        return value >= MODULUS ? value - MODULUS : value;
+    }
+
+    uint64_t power(uint64_t base, long long exponent) {
+        uint64_t value = 1;
+        for (; exponent > 0; exponent >>= 1) {
+            if (exponent & 1) {
+                value = multiply(value, base);
+            }
+            base = multiply(base, base);
+        }
+        return value;
+    }
+
+    void addOp(void *in, void *inout, int *count, MPI_Datatype *) {
+        const uint64_t *first = static_cast<const uint64_t *>(in);
+        uint64_t *second = static_cast<uint64_t *>(inout);
+        for (int i = 0; i < *count; i++) {
+            second[i] = Checksum::add(first[i], second[i]);
+        }
+    }
+
+    string sidecar(const string &resultFile) {
+        return resultFile + ".sum";
+    }
+}
+
+uint64_t Checksum::hash(const BigNumber::Limb *block, const long long size, const long long start) {
+    // Horner from the top limb, then shifted to the position of the block
+    uint64_t value = 0;
+    for (long long i = size - 1; i >= 0; i--) {
+        value = multiply(value, RADIX) + block[i];
+        value = value >= MODULUS ? value - MODULUS : value;
+    }
+    return multiply(value, power(RADIX, start));
+}
+
+uint64_t Checksum::add(const uint64_t first, const uint64_t second) {
+    const uint64_t value = first + second;
+    return value >= MODULUS ? value - MODULUS : value;
+}
+
+void Checksum::reduce(const string &resultFile, const BigNumber::Limb *block, const long long size,
+                      const long long start, const BigNumber::Limb carry, const bool top, MPI_Comm comm) {
+    uint64_t part = hash(block, size, start);
+    if (top) {
+        // the carry out of the top limb is the limb right after it
+        part = add(part, hash(&carry, 1, start + size));
+    }
+    MPI_Op op;
+    MPI_Op_create(addOp, 1, &op);
+    uint64_t total = 0;
+    MPI_Reduce(&part, &total, 1, MPI_UINT64_T, op, 0, comm);
+    MPI_Op_free(&op);
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0) {
+        write(resultFile, total);
+    }
+}
+
+void Checksum::write(const string &resultFile, const uint64_t hash) {
+    ofstream out(sidecar(resultFile));
+    if (!out) {
+        cerr << "Checksum file could not be opened" << endl;
+        return;
+    }
+    out << hex << hash << "\n";
+}
+
+bool Checksum::read(const string &resultFile, uint64_t &hash) {
+    ifstream in(sidecar(resultFile));
+    return (bool) (in >> hex >> hash);
+}
+
+void Checksum::remove(const string &resultFile) {
+    std::remove(sidecar(resultFile).c_str());
+}
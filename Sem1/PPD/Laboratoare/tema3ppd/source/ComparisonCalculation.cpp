@@ -0,0 +1,73 @@
+#include "../header/ComparisonCalculation.h"
+#include <fstream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+
+using namespace std;
+
+namespace {
+    // layout matches MPI_2INT
+    struct Difference {
+        int limb;   // global index of the most significant differing limb, -1 if none
+        int order;  // comparison at that limb
+    };
+}
+
+void ComparisonCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+int ComparisonCalculation::globalOrder(const BigNumber::Limb *first, const BigNumber::Limb *second, const int size,
+                                       const int blockStart, MPI_Comm comm) {
+    Difference local;
+    const long long limb = BigNumber::topDifference(first, second, size, local.order);
+    local.limb = limb < 0 ? -1 : blockStart + (int) limb;
+    // cea mai semnificativa diferenta decide; daca nu exista, toate ordinele sunt 0
+    Difference global;
+    MPI_Allreduce(&local, &global, 1, MPI_2INT, MPI_MAXLOC, comm);
+    return global.order;
+}
+
+void ComparisonCalculation::calculator(int rank) {
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(totalSize, P, blockStart, blockSize);
+
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    int sizes[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", 0, &sizes[0]);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", 0, &sizes[1]);
+    }
+    MPI_Bcast(sizes, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::READ);
+
+    const int batchSize = blockSize[rank];
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    ScattervCalculation::scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc, MPI_COMM_WORLD);
+    ScattervCalculation::scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    const int order = globalOrder(first_loc, second_loc, batchSize, blockStart[rank], MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::COMPUTE);
+    if (rank == 0) {
+        ofstream outC("resultCompare.txt");
+        outC << order << "\n";
+        outC.close();
+        Benchmark::lap(Benchmark::WRITE);
+    }
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
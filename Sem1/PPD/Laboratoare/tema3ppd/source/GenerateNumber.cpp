@@ -1,91 +1,443 @@
 #include "../header/GenerateNumber.h"
+#include "../header/BufferPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+namespace {
+    const char NUMBER_MAGIC[4] = {'B', 'N', 'U', 'M'};
+    const uint32_t NUMBER_VERSION = 1;
 
-void GenerateNumber::generateNumber(const string &fileName, const int numberOfDigits) {
-    int *table = new int[numberOfDigits];
-    for (int i = 0; i < numberOfDigits - 1; i++) {
-        table[i] = rand() % 10;
+    NumberFileHeader makeHeader(const long long numberOfDigits) {
+        NumberFileHeader header;
+        memcpy(header.magic, NUMBER_MAGIC, sizeof(NUMBER_MAGIC));
+        header.version = NUMBER_VERSION;
+        header.numberOfDigits = numberOfDigits;
+        return header;
     }
-    table[numberOfDigits - 1] = (rand() % 9) + 1;
 
-    ofstream out(fileName);
-    out << numberOfDigits << endl;
-    for (int i = 0; i < numberOfDigits; i++) {
-        out << table[i] << " ";
+    // Read-only memory mapping of a binary number file.
+    // Only the pages of the requested slice are ever touched.
+    class MappedNumber {
+    private:
+        void *base = nullptr;
+        size_t length = 0;
+    public:
+        explicit MappedNumber(const string &fileName) {
+            const int fd = open(fileName.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return;
+            }
+            struct stat info;
+            if (fstat(fd, &info) == 0 && info.st_size >= (off_t) sizeof(NumberFileHeader)) {
+                void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    base = mapped;
+                    length = info.st_size;
+                }
+            }
+            close(fd);
+
+            if (base != nullptr) {
+                const NumberFileHeader *header = static_cast<const NumberFileHeader *>(base);
+                const bool valid = memcmp(header->magic, NUMBER_MAGIC, sizeof(NUMBER_MAGIC)) == 0
+                                   && header->version == NUMBER_VERSION
+                                   && header->numberOfDigits <= length - sizeof(NumberFileHeader);
+                if (!valid) {
+                    munmap(base, length);
+                    base = nullptr;
+                }
+            }
+        }
+
+        ~MappedNumber() {
+            if (base != nullptr) {
+                munmap(base, length);
+            }
+        }
+
+        MappedNumber(const MappedNumber &) = delete;
+        MappedNumber &operator=(const MappedNumber &) = delete;
+
+        bool isOpen() const {
+            return base != nullptr;
+        }
+
+        long long numberOfDigits() const {
+            return (long long) static_cast<const NumberFileHeader *>(base)->numberOfDigits;
+        }
+
+        const uint8_t *digits() const {
+            return static_cast<const uint8_t *>(base) + sizeof(NumberFileHeader);
+        }
+    };
+
+    // digits are generated in blocks of this many digits (one random stream each)
+    // and written in windows of the same size
+    const long long GENERATE_WINDOW = 1 << 20;
+
+    // splitmix64 finalizer
+    uint64_t mix(uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    // splitmix64 stream of block number block, 8 digits per 64-bit draw: each digit is the
+    // integer part of 10 * the remaining fraction
+    void generateBlock(const uint64_t seed, const long long block, uint8_t *digits, const long long count) {
+        uint64_t state = mix(seed ^ mix((uint64_t) block + 0x9e3779b97f4a7c15ULL));
+        for (long long i = 0; i < count; i += 8) {
+            state += 0x9e3779b97f4a7c15ULL;
+            uint64_t fraction = mix(state);
+            const int steps = (int) min<long long>(8, count - i);
+            for (int j = 0; j < steps; j++) {
+                const unsigned __int128 product = (unsigned __int128) fraction * 10;
+                digits[i + j] = (uint8_t) (product >> 64);
+                fraction = (uint64_t) product;
+            }
+        }
+    }
+
+    // digits of a run in ALTERNATING and of the ripple past a boundary in BOUNDARY
+    const long long RUN_DIGITS = 1024;
+    const char *PROFILE_NAMES[] = {"random", "nines", "alternating", "boundary", "block-nines"};
+
+    // first digit of block b when limbs limbs are split in blocks blocks like the parallel variants:
+    // the first limbs % blocks blocks get one limb more
+    long long blockStart(const long long b, const long long limbs, const int blocks) {
+        const long long dimension = limbs / blocks;
+        const long long extra = limbs % blocks;
+        return (b * dimension + min(b, extra)) * BigNumber::DIGITS_PER_LIMB;
+    }
+
+    long long blockOf(const long long digit, const long long limbs, const int blocks) {
+        const long long dimension = limbs / blocks;
+        const long long extra = limbs % blocks;
+        const long long limb = digit / BigNumber::DIGITS_PER_LIMB;
+        if (limb < extra * (dimension + 1)) {
+            return limb / (dimension + 1);
+        }
+        if (dimension == 0) {
+            return blocks - 1;
+        }
+        return min<long long>(blocks - 1, extra + (limb - extra * (dimension + 1)) / dimension);
+    }
+
+    // overwrites the digits the profile fixes, count digits from position start of operand
+    // 0 (first) or 1 (second); the others keep their random value
+    void applyProfile(const GenerateNumber::Options &options, const int operand, const long long limbs,
+                      const long long start, uint8_t *digits, const long long count) {
+        if (options.profile == GenerateNumber::RANDOM) {
+            return;
+        }
+        const int blocks = max(1, options.blocks);
+        for (long long i = 0; i < count; i++) {
+            const long long position = start + i;
+            int first = -1;
+            int second = 0;
+            switch (options.profile) {
+                case GenerateNumber::NINES:
+                    first = 9;
+                    second = position == 0 ? 1 : 0;
+                    break;
+                case GenerateNumber::ALTERNATING:
+                    if ((position / RUN_DIGITS) % 2 == 0) {
+                        first = 9;
+                        second = position % RUN_DIGITS == 0 ? 1 : 0;
+                    }
+                    break;
+                default: {
+                    const long long b = blockOf(position, limbs, blocks);
+                    if (b + 1 < blocks && position == blockStart(b + 1, limbs, blocks) - 1) {
+                        // 9 + 9 carries out of the block whatever carry comes in
+                        first = 9;
+                        second = 9;
+                    } else if (options.profile == GenerateNumber::BOUNDARY
+                               ? b > 0 && position - blockStart(b, limbs, blocks) < RUN_DIGITS
+                               : b % 2 == 1) {
+                        first = 9;
+                    }
+                    break;
+                }
+            }
+            if (first >= 0) {
+                digits[i] = (uint8_t) (operand == 0 ? first : second);
+            }
+        }
+    }
+
+    // collective on comm, see GenerateNumber::generateNumber
+    void generateFile(const string &fileName, const long long numberOfDigits, const uint64_t seed, MPI_Comm comm,
+                      const GenerateNumber::Options &options, const int operand, const long long limbs) {
+        int rank;
+        int P;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &P);
+        MPI_File file;
+        if (MPI_File_open(comm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+            if (rank == 0) {
+                cerr << "Number file could not be opened" << endl;
+            }
+            return;
+        }
+        MPI_File_set_size(file, 0);
+        if (rank == 0) {
+            NumberFileHeader header = makeHeader(numberOfDigits);
+            MPI_File_write_at(file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+
+        // fiecare proces genereaza blocuri intregi, deci cifrele nu depind de P
+        const long long blocks = (numberOfDigits + GENERATE_WINDOW - 1) / GENERATE_WINDOW;
+        const long long firstBlock = blocks * rank / P;
+        const long long lastBlock = blocks * (rank + 1) / P;
+        uint8_t *table = BufferPool::acquire<uint8_t>(GENERATE_WINDOW);
+        for (long long block = firstBlock; block < lastBlock; block++) {
+            const long long start = block * GENERATE_WINDOW;
+            const long long count = min(GENERATE_WINDOW, numberOfDigits - start);
+            generateBlock(seed, block, table, count);
+            if (start + count == numberOfDigits) {
+                table[count - 1] = (uint8_t) (1 + mix(seed ^ (uint64_t) numberOfDigits) % 9);
+            }
+            applyProfile(options, operand, limbs, start, table, count);
+            if (start + count == numberOfDigits && table[count - 1] == 0) {
+                // the most significant digit is never 0
+                table[count - 1] = 1;
+            }
+            MPI_File_write_at(file, (MPI_Offset) (sizeof(NumberFileHeader) + start), table, (int) count, MPI_BYTE,
+                              MPI_STATUS_IGNORE);
+        }
+        BufferPool::release(table);
+        MPI_File_close(&file);
+    }
+
+    bool writeBinary(const string &fileName, const uint8_t *digits, const long long numberOfDigits) {
+        ofstream out(fileName, ios::binary);
+        if (!out) {
+            cerr << "Number file could not be opened" << endl;
+            return false;
+        }
+        GenerateNumber::writeHeader(out, numberOfDigits);
+        out.write(reinterpret_cast<const char *>(digits), numberOfDigits);
+        return (bool) out;
     }
-    delete[] table;
 }
 
-int *GenerateNumber::readNumber(const string &fileName) {
-    ifstream in(fileName);
-    if (!in) {
-        cerr << "Number file could not be opened" << endl;
+void GenerateNumber::writeHeader(ostream &out, const long long numberOfDigits) {
+    const NumberFileHeader header = makeHeader(numberOfDigits);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+
+void GenerateNumber::generateNumber(const string &fileName, const long long numberOfDigits, const uint64_t seed,
+                                    MPI_Comm comm) {
+    Options options;
+    options.seed = seed;
+    generateFile(fileName, numberOfDigits, seed, comm, options, 0, BigNumber::limbCount(numberOfDigits));
+}
+
+void GenerateNumber::generateOperands(const long long N1, const long long N2, const Options &options, MPI_Comm comm) {
+    // the blocks of the profiles are blocks of the longest operand, like in the variants
+    const long long limbs = BigNumber::limbCount(max(N1, N2));
+    generateFile("firstNumber.bin", N1, 2 * options.seed, comm, options, 0, limbs);
+    generateFile("secondNumber.bin", N2, 2 * options.seed + 1, comm, options, 1, limbs);
+}
+
+bool GenerateNumber::parseProfile(const string &name, Profile &profile) {
+    for (int i = RANDOM; i <= BLOCK_NINES; i++) {
+        if (name == PROFILE_NAMES[i]) {
+            profile = (Profile) i;
+            return true;
+        }
     }
-    int numberOfDigits;
-    in >> numberOfDigits;
-    int *table = new int[numberOfDigits];
-    int digit;
-    for (int i = 0; i < numberOfDigits; i++) {
-        in >> digit;
-        table[i] = digit;
+    return false;
+}
+
+const char *GenerateNumber::profileName(const Profile profile) {
+    return PROFILE_NAMES[profile];
+}
+
+BigNumber GenerateNumber::readNumber(const string &fileName) {
+    MappedNumber mapped(fileName);
+    if (!mapped.isOpen()) {
+        cerr << "Number file could not be opened" << endl;
+        return BigNumber();
     }
-    return table;
+    const long long numberOfDigits = mapped.numberOfDigits();
+    BigNumber number(numberOfDigits);
+    BigNumber::packDigits(mapped.digits(), numberOfDigits, number.data(), number.getSize());
+    return number;
 }
-int *GenerateNumber::readNumberP(const string &fileName,const int P) {
-    ifstream in(fileName);
-    if (!in) {
+BigNumber::Limb *GenerateNumber::readNumberP(const string &fileName,const int totalSize,int *numberSize) {
+    MappedNumber mapped(fileName);
+    if (!mapped.isOpen()) {
         cerr << "Number file could not be opened" << endl;
     }
-    int numberOfDigits;
-    int* table;
-    in >> numberOfDigits;
-    if (numberOfDigits < P) {
-        table=new int[P];
-        for (int i = numberOfDigits; i < P; i++) {
-            table[i] = 0;
-        }
+    const long long numberOfDigits = mapped.isOpen() ? mapped.numberOfDigits() : 0;
+    const long long size = BigNumber::limbCount(numberOfDigits);
+    if (numberSize != nullptr) {
+        *numberSize = (int) size;
     }
-    else {
-       table = new int[numberOfDigits];
+    BigNumber::Limb* table = BufferPool::acquire<BigNumber::Limb>(size < totalSize ? totalSize : size);
+    for (long long i = size; i < totalSize; i++) {
+        table[i] = 0;
     }
-    int digit;
-    for (int i = 0; i < numberOfDigits; i++) {
-        in >> digit;
-        table[i] = digit;
+    if (mapped.isOpen()) {
+        BigNumber::packDigits(mapped.digits(), numberOfDigits, table, size);
     }
     return table;
 }
 
-void GenerateNumber::writeNumber(const string &fileName, int *number, const int numberOfDigits) {
-    ofstream out(fileName);
+void GenerateNumber::writeNumber(const string &fileName, const BigNumber &number) {
+    ofstream out(fileName, ios::binary);
     if (!out) {
         cerr << "Number file could not be opened" << endl;
+        return;
     }
-    cout << numberOfDigits << endl;
-    for (int i = 0; i < numberOfDigits; i++) {
-        out << number[i] << " ";
+    const long long numberOfDigits = number.getNumberOfDigits();
+    writeHeader(out, numberOfDigits);
+    // unpacked one window of whole limbs at a time
+    const long long windowLimbs = GENERATE_WINDOW / BigNumber::DIGITS_PER_LIMB;
+    uint8_t *table = BufferPool::acquire<uint8_t>(windowLimbs * BigNumber::DIGITS_PER_LIMB);
+    for (long long limb = 0; limb * BigNumber::DIGITS_PER_LIMB < numberOfDigits; limb += windowLimbs) {
+        const long long count = min(windowLimbs * BigNumber::DIGITS_PER_LIMB,
+                                    numberOfDigits - limb * BigNumber::DIGITS_PER_LIMB);
+        BigNumber::unpackDigits(number.data() + limb, count, table);
+        out.write(reinterpret_cast<const char *>(table), count);
     }
+    BufferPool::release(table);
 }
 
-int *GenerateNumber::readNumberBlock(const string &fileName, const int offset, const int size) {
-    ifstream in(fileName);
-    int numberOfDigits;
-    in >> numberOfDigits;
-    int *table = new int[size];
-    int initialIndex = 0;
-    int idx;
-    for (int i = 0; i < numberOfDigits && (numberOfDigits > offset); i++) {
-        in >> idx;
-        if (i >= offset && initialIndex < size) {
-            table[initialIndex] = idx;
-            initialIndex++;
+BigNumber::Limb *GenerateNumber::readNumberBlock(const string &fileName, const long long offset, const int size) {
+    BigNumber::Limb *table = BufferPool::acquire<BigNumber::Limb>(size);
+    readNumberBlock(fileName, offset, size, table);
+    return table;
+}
+
+void GenerateNumber::readNumberBlock(const string &fileName, const long long offset, const int size,
+                                     BigNumber::Limb *table) {
+    MappedNumber mapped(fileName);
+    long long numberOfDigits = 0;
+    if (mapped.isOpen()) {
+        numberOfDigits = mapped.numberOfDigits();
+    } else {
+        cerr << "Number file could not be opened" << endl;
+    }
+    // only the digits of this block are touched
+    const long long firstDigit = offset * BigNumber::DIGITS_PER_LIMB;
+    const long long count = firstDigit < numberOfDigits ? numberOfDigits - firstDigit : 0;
+    const uint8_t *digits = count > 0 ? mapped.digits() + firstDigit : nullptr;
+    BigNumber::packDigits(digits, count, table, size);
+}
+
+void GenerateNumber::readNumberBlockAll(MPI_Comm comm, const string &fileName, const long long offset, const int size,
+                                        BigNumber::Limb *table) {
+    MPI_File file;
+    if (MPI_File_open(comm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        cerr << "Number file could not be opened" << endl;
+        BigNumber::packDigits(nullptr, 0, table, size);
+        return;
+    }
+    NumberFileHeader header;
+    MPI_File_read_at_all(file, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+    long long numberOfDigits = (long long) header.numberOfDigits;
+    if (memcmp(header.magic, NUMBER_MAGIC, sizeof(NUMBER_MAGIC)) != 0 || header.version != NUMBER_VERSION) {
+        cerr << "Number file could not be opened" << endl;
+        numberOfDigits = 0;
+    }
+
+    // one byte per digit, so the slice starts at a computable offset
+    // a block holds at most INT_MAX / 2 digits (checked in main), so count fits an MPI count
+    const long long firstDigit = offset * BigNumber::DIGITS_PER_LIMB;
+    int count = firstDigit < numberOfDigits ? (int) min<long long>(numberOfDigits - firstDigit,
+                                                                   (long long) size * BigNumber::DIGITS_PER_LIMB) : 0;
+    uint8_t *digits = BufferPool::acquire<uint8_t>(count);
+    MPI_File_read_at_all(file, sizeof(NumberFileHeader) + firstDigit, digits, count, MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+
+    BigNumber::packDigits(digits, count, table, size);
+    BufferPool::release(digits);
+}
+
+long long GenerateNumber::readNumberOfDigits(const string &fileName) {
+    MappedNumber mapped(fileName);
+    return mapped.isOpen() ? mapped.numberOfDigits() : -1;
+}
+
+bool GenerateNumber::readText(const string &fileName, string &text) {
+    ifstream in(fileName, ios::binary | ios::ate);
+    if (!in) {
+        return false;
+    }
+    text.resize((size_t) in.tellg());
+    in.seekg(0);
+    in.read(&text[0], (streamsize) text.size());
+    return true;
+}
+
+bool GenerateNumber::convertTextToBinary(const string &textFile, const string &binaryFile) {
+    string text;
+    if (!readText(textFile, text)) {
+        cerr << "Number file could not be opened" << endl;
+        return false;
+    }
+    // input files start with the digit count alone on the first line, result files ("d d d ") do not
+    const size_t lineEnd = min(text.find('\n'), text.size());
+    const string firstLine = text.substr(0, lineEnd);
+    const bool hasCount = !firstLine.empty() && firstLine.find(' ') == string::npos;
+    const size_t digitsStart = hasCount ? lineEnd : 0;
+    vector<uint8_t> digits(text.size() + 1);
+    const long long count = BigNumber::parseDigits(text.data() + digitsStart, (long long) (text.size() - digitsStart),
+                                                   digits.data());
+    // every character that is not whitespace must be a digit
+    if (find_if(digits.begin(), digits.begin() + count, [](uint8_t value) { return value > 9; }) !=
+        digits.begin() + count) {
+        cerr << "Number file " << textFile << " holds a character that is not a digit" << endl;
+        return false;
+    }
+    if (hasCount) {
+        char *end = nullptr;
+        errno = 0;
+        const long long value = strtoll(firstLine.c_str(), &end, 10);
+        if (errno != 0 || end == firstLine.c_str() || *end != '\0' || value != count) {
+            cerr << "Number file " << textFile << " announces " << firstLine << " digits but holds " << count << endl;
+            return false;
+        }
+    }
+    return writeBinary(binaryFile, digits.data(), count);
+}
+
+bool GenerateNumber::convertBinaryToText(const string &binaryFile, const string &textFile) {
+    MappedNumber mapped(binaryFile);
+    if (!mapped.isOpen()) {
+        cerr << "Number file could not be opened" << endl;
+        return false;
+    }
+    ofstream out(textFile);
+    const long long numberOfDigits = mapped.numberOfDigits();
+    const uint8_t *digits = mapped.digits();
+    out << numberOfDigits << '\n';
+    // "d " pairs formatted a chunk at a time, one out.write per chunk
+    char buffer[2 * BigNumber::WRITE_CHUNK_DIGITS];
+    for (long long first = 0; first < numberOfDigits; first += BigNumber::WRITE_CHUNK_DIGITS) {
+        const long long count = min<long long>(BigNumber::WRITE_CHUNK_DIGITS, numberOfDigits - first);
+        for (long long i = 0; i < count; i++) {
+            buffer[2 * i] = (char) ('0' + digits[first + i]);
+            buffer[2 * i + 1] = ' ';
         }
+        out.write(buffer, 2 * count);
     }
-    while (initialIndex < size) {
-        table[initialIndex] = 0;
-        initialIndex++;
+    if (!out) {
+        cerr << "Text file " << textFile << " could not be written" << endl;
+        return false;
     }
-    return table;
+    return true;
 }
@@ -0,0 +1,189 @@
+#include "../header/HybridCalculation.h"
+#include <mpi.h>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/LookaheadCalculation.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+namespace {
+    // cores of this node shared between the ranks placed on it
+    int defaultThreads() {
+        MPI_Comm node;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+        int ranksOnNode;
+        MPI_Comm_size(node, &ranksOnNode);
+        MPI_Comm_free(&node);
+        const int cores = (int) thread::hardware_concurrency();
+        return cores > ranksOnNode ? cores / ranksOnNode : 1;
+    }
+
+    int clampCount(const int count, const int start, const int length) {
+        const int available = count - start;
+        return available <= 0 ? 0 : (available < length ? available : length);
+    }
+}
+
+void HybridCalculation::run() {
+    int rank;
+    MPI_Comm_rank(topology != nullptr ? topology->blocks : MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void HybridCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, blocks as in Variant 2.1
+    MPI_Comm comm = topology != nullptr ? topology->blocks : MPI_COMM_WORLD;
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(totalSize, P, blockStart, blockSize);
+
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    int sizes[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", 0, &sizes[0]);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", 0, &sizes[1]);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    MPI_Bcast(sizes, 2, MPI_INT, 0, comm);
+    Benchmark::lap(Benchmark::READ);
+
+    int *firstCounts = BufferPool::acquire<int>(P);
+    int *firstDispls = BufferPool::acquire<int>(P);
+    int *secondCounts = BufferPool::acquire<int>(P);
+    int *secondDispls = BufferPool::acquire<int>(P);
+    ScattervCalculation::operandLayout(blockStart, blockSize, P, sizes[0], firstCounts, firstDispls);
+    ScattervCalculation::operandLayout(blockStart, blockSize, P, sizes[1], secondCounts, secondDispls);
+
+    const int batchSize = blockSize[rank];
+    int firstCount = firstCounts[rank];
+    int secondCount = secondCounts[rank];
+    BigNumber::Limb *first_loc;
+    BigNumber::Limb *second_loc;
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    if (topology != nullptr) {
+        // prin leader-ul nodului, blocurile vin completate cu 0
+        firstCount = secondCount = batchSize;
+        first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+        second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+        topology->scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc);
+        topology->scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc);
+    } else {
+        first_loc = BufferPool::acquire<BigNumber::Limb>(firstCount);
+        second_loc = BufferPool::acquire<BigNumber::Limb>(secondCount);
+        MPI_Scatterv(firstNumber, firstCounts, firstDispls, MPI_LIMB,
+                     first_loc, firstCount, MPI_LIMB, 0, comm);
+        MPI_Scatterv(secondNumber, secondCounts, secondDispls, MPI_LIMB,
+                     second_loc, secondCount, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    // blocul procesului e impartit intre thread-uri, fiecare isi calculeaza (generate, propagate)
+    int teamSize = threads > 0 ? threads : defaultThreads();
+    if (teamSize > batchSize) {
+        teamSize = batchSize > 0 ? batchSize : 1;
+    }
+    vector<int> partStart(teamSize + 1);
+    for (int t = 0; t <= teamSize; t++) {
+        partStart[t] = (int) ((long long) batchSize * t / teamSize);
+    }
+    vector<BigNumber::Limb> generate(teamSize);
+    vector<int> run(teamSize);
+    vector<thread> team;
+    for (int t = 0; t < teamSize; t++) {
+        team.emplace_back([&, t]() {
+            const int start = partStart[t];
+            const int length = partStart[t + 1] - start;
+            const int firstPart = clampCount(firstCount, start, length);
+            const int secondPart = clampCount(secondCount, start, length);
+            generate[t] = BigNumber::sum(first_loc + (firstPart > 0 ? start : 0), firstPart,
+                                         second_loc + (secondPart > 0 ? start : 0), secondPart,
+                                         result_loc + start, length);
+            run[t] = (int) BigNumber::carryRun(result_loc + start, length);
+        });
+    }
+    for (thread &worker: team) {
+        worker.join();
+    }
+
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    // carry-urile dintre thread-uri se rezolva in memoria comuna, doar cel dintre procese trece prin MPI
+    BigNumber::Limb blockGenerate = 0;
+    bool blockPropagate = true;
+    for (int t = 0; t < teamSize; t++) {
+        const bool propagate = run[t] == partStart[t + 1] - partStart[t];
+        blockGenerate = generate[t] | (propagate & blockGenerate);
+        blockPropagate = blockPropagate && propagate;
+    }
+    const BigNumber::Limb incoming = LookaheadCalculation::incomingCarry(blockGenerate, blockPropagate, comm);
+
+    vector<BigNumber::Limb> partIncoming(teamSize);
+    BigNumber::Limb carry = incoming;
+    for (int t = 0; t < teamSize; t++) {
+        partIncoming[t] = carry;
+        const bool propagate = run[t] == partStart[t + 1] - partStart[t];
+        carry = generate[t] | (propagate & carry);
+    }
+    team.clear();
+    for (int t = 0; t < teamSize; t++) {
+        if (partIncoming[t]) {
+            team.emplace_back([&, t]() {
+                BigNumber::selectCarry(result_loc + partStart[t], partStart[t + 1] - partStart[t], run[t]);
+            });
+        }
+    }
+    for (thread &worker: team) {
+        worker.join();
+    }
+
+    // ultimul proces trimite carry la master
+    if (rank == P - 1 && P > 1) {
+        MPI_Send(&carry, 1, MPI_LIMB, 0, 5, comm);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultHybrid.txt", result_loc, batchSize, blockStart[rank], carry, rank == P - 1, comm);
+    }
+    if (topology != nullptr) {
+        topology->gatherBlocks(result_loc, blockStart, blockSize, result);
+    } else {
+        MPI_Gatherv(result_loc, batchSize, MPI_LIMB, result, blockSize, blockStart, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::GATHER);
+    if (rank == 0) {
+        ofstream outH("resultHybrid.txt");
+        BigNumber::writeDigits(outH, result, totalSize, N_Max);
+        BigNumber::Limb final_carry = carry;
+        if (P > 1) {
+            MPI_Recv(&final_carry, 1, MPI_LIMB, P - 1, 5, comm, MPI_STATUS_IGNORE);
+        }
+        final_carry = BigNumber::overflowDigit(totalSize > 0 ? result[totalSize - 1] : 0, N_Max, final_carry);
+        if (final_carry > 0) {
+            outH << final_carry << "\n";
+        }
+        outH.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+    }
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(firstCounts);
+    BufferPool::release(firstDispls);
+    BufferPool::release(secondCounts);
+    BufferPool::release(secondDispls);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
@@ -0,0 +1,138 @@
+#include "../header/LookaheadCalculation.h"
+#include <fstream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+namespace {
+    // layout matches MPI_2INT
+    struct CarrySummary {
+        int generate;   // block produces a carry on its own
+        int propagate;  // block forwards an incoming carry (all limbs are BASE - 1)
+    };
+}
+
+void LookaheadCalculation::run() {
+    int rank;
+    MPI_Comm_rank(topology != nullptr ? topology->blocks : MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void LookaheadCalculation::combineCarry(void *in, void *inout, int *len, MPI_Datatype *) {
+    // in holds the lower blocks, inout the higher ones
+    const CarrySummary *lower = static_cast<CarrySummary *>(in);
+    CarrySummary *higher = static_cast<CarrySummary *>(inout);
+    for (int i = 0; i < *len; i++) {
+        higher[i].generate = higher[i].generate | (higher[i].propagate & lower[i].generate);
+        higher[i].propagate = higher[i].propagate & lower[i].propagate;
+    }
+}
+
+BigNumber::Limb LookaheadCalculation::incomingCarry(const BigNumber::Limb generate, const bool propagate, MPI_Comm comm) {
+    CarrySummary local = {(int) generate, propagate};
+    CarrySummary incoming = {0, 1};
+    MPI_Op carryOp;
+    MPI_Op_create(&LookaheadCalculation::combineCarry, 0, &carryOp);
+    MPI_Exscan(&local, &incoming, 1, MPI_2INT, carryOp, comm);
+    MPI_Op_free(&carryOp);
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    // MPI_Exscan leaves rank 0's buffer undefined
+    return rank == 0 ? 0 : incoming.generate;
+}
+
+void LookaheadCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits
+    MPI_Comm comm = topology != nullptr ? topology->blocks : MPI_COMM_WORLD;
+    const int size = (int) BigNumber::limbCount(N_Max);
+    const int totalSize = size % P == 0 ? size : size + (P - (size % P));
+    const int dimension = totalSize / P;
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", totalSize);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", totalSize);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    Benchmark::lap(Benchmark::READ);
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(dimension);
+    BigNumber::Limb *second_loc = BufferPool::acquire<BigNumber::Limb>(dimension);
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(dimension);
+    // equal blocks, through the node leaders with a Topology
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    for (int pid = 0; pid < P; pid++) {
+        blockStart[pid] = pid * dimension;
+        blockSize[pid] = dimension;
+    }
+    if (topology != nullptr) {
+        topology->scatterBlocks(firstNumber, totalSize, blockStart, blockSize, first_loc);
+        topology->scatterBlocks(secondNumber, totalSize, blockStart, blockSize, second_loc);
+    } else {
+        MPI_Scatter(firstNumber, dimension, MPI_LIMB, first_loc, dimension, MPI_LIMB, 0, comm);
+        MPI_Scatter(secondNumber, dimension, MPI_LIMB, second_loc, dimension, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    // fiecare proces calculeaza suma portiunii sale si perechea (generate, propagate)
+    const BigNumber::Limb generate = BigNumber::sum(first_loc, second_loc, result_loc, dimension);
+    const int run = (int) BigNumber::carryRun(result_loc, dimension);
+    const bool propagate = run == dimension;
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    // carry-ul de intrare al fiecarui bloc vine dintr-un singur prefix scan, O(log P)
+    const BigNumber::Limb incoming = incomingCarry(generate, propagate, comm);
+
+    BigNumber::Limb carry = generate;
+    if (incoming) {
+        carry += propagate;
+        BigNumber::selectCarry(result_loc, dimension, run);
+    }
+
+    // ultimul proces trimite carry la master
+    if (rank == P - 1 && P > 1) {
+        MPI_Send(&carry, 1, MPI_LIMB, 0, 5, comm);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultLookahead.txt", result_loc, dimension, (long long) rank * dimension, carry, rank == P - 1, comm);
+    }
+    if (topology != nullptr) {
+        topology->gatherBlocks(result_loc, blockStart, blockSize, result);
+    } else {
+        MPI_Gather(result_loc, dimension, MPI_LIMB, result, dimension, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::GATHER);
+    if (rank == 0) {
+        ofstream outL("resultLookahead.txt");
+        BigNumber::writeDigits(outL, result, size, N_Max);
+        BigNumber::Limb final_carry = carry;
+        if (P > 1) {
+            MPI_Recv(&final_carry, 1, MPI_LIMB, P - 1, 5, comm, MPI_STATUS_IGNORE);
+        }
+        // with padding the carry out of the number lands in the first padded limb
+        if (size < totalSize) {
+            final_carry = result[size];
+        }
+        final_carry = BigNumber::overflowDigit(size > 0 ? result[size - 1] : 0, N_Max, final_carry);
+        if (final_carry > 0) {
+            outL << final_carry << "\n";
+        }
+        outL.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(firstNumber);
+        BufferPool::release(secondNumber);
+        BufferPool::release(result);
+    }
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
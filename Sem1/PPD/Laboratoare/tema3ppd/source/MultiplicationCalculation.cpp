@@ -0,0 +1,97 @@
+#include "../header/MultiplicationCalculation.h"
+#include <mpi.h>
+#include <fstream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+
+using namespace std;
+
+void MultiplicationCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void MultiplicationCalculation::calculator(int rank) {
+    BigNumber firstNumber;
+    BigNumber secondNumber;
+    long long digits[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumber("firstNumber.bin");
+        secondNumber = GenerateNumber::readNumber("secondNumber.bin");
+        digits[0] = firstNumber.getNumberOfDigits();
+        digits[1] = secondNumber.getNumberOfDigits();
+    }
+    MPI_Bcast(digits, 2, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+    const int firstSize = (int) BigNumber::limbCount(digits[0]);
+    const int secondSize = (int) BigNumber::limbCount(digits[1]);
+    if (rank != 0) {
+        secondNumber = BigNumber(digits[1]);
+    }
+    Benchmark::lap(Benchmark::READ);
+
+    // primul numar se imparte in blocuri, al doilea ajunge intreg la fiecare proces
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(firstSize, P, blockStart, blockSize);
+    const int batchSize = blockSize[rank];
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    ScattervCalculation::scatterBlocks(firstNumber.data(), firstSize, blockStart, blockSize, first_loc, MPI_COMM_WORLD);
+    MPI_Bcast(secondNumber.data(), secondSize, MPI_LIMB, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    // produsul blocului incepe la limb-ul blockStart[rank] al rezultatului
+    const int productSize = batchSize + secondSize;
+    BigNumber::Limb *product_loc = BufferPool::acquire<BigNumber::Limb>(productSize);
+    BigNumber::multiply(first_loc, batchSize, secondNumber.data(), secondSize, product_loc);
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    int *productCounts = BufferPool::acquire<int>(P);
+    int *productDispls = BufferPool::acquire<int>(P);
+    int totalProducts = 0;
+    for (int pid = 0; pid < P; pid++) {
+        productCounts[pid] = blockSize[pid] + secondSize;
+        productDispls[pid] = totalProducts;
+        totalProducts += productCounts[pid];
+    }
+    BigNumber::Limb *products = rank == 0 ? BufferPool::acquire<BigNumber::Limb>(totalProducts) : nullptr;
+    MPI_Gatherv(product_loc, productSize, MPI_LIMB, products, productCounts, productDispls, MPI_LIMB, 0,
+                MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::GATHER);
+
+    if (rank == 0) {
+        // produsele partiale se suprapun, master-ul le aduna deplasate
+        BigNumber result(digits[0] + digits[1]);
+        const int resultSize = (int) result.getSize();
+        for (int i = 0; i < resultSize; i++) {
+            result.data()[i] = 0;
+        }
+        for (int pid = 0; pid < P; pid++) {
+            const int length = productCounts[pid] < resultSize - blockStart[pid]
+                               ? productCounts[pid] : resultSize - blockStart[pid];
+            BigNumber::Limb *target = result.data() + blockStart[pid];
+            BigNumber::Limb carry = BigNumber::sum(target, products + productDispls[pid], target, length);
+            BigNumber::passCarry(target + length, resultSize - blockStart[pid] - length, carry);
+        }
+        Benchmark::lap(Benchmark::CARRY);
+
+        // the product has digits[0] + digits[1] digits or one less
+        if (result.getNumberOfDigits() > 1 && result.digit(result.getNumberOfDigits() - 1) == 0) {
+            result.resize(result.getNumberOfDigits() - 1);
+        }
+        ofstream outM("resultMultiply.txt");
+        BigNumber::writeDigits(outM, result.data(), result.getSize(), result.getNumberOfDigits());
+        outM.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(products);
+    }
+    BufferPool::release(first_loc);
+    BufferPool::release(product_loc);
+    BufferPool::release(productCounts);
+    BufferPool::release(productDispls);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
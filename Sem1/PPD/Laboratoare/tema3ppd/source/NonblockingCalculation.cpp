@@ -0,0 +1,149 @@
+#include "../header/NonblockingCalculation.h"
+#include <mpi.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+void NonblockingCalculation::run() {
+    int rank;
+    MPI_Comm_rank(topology != nullptr ? topology->blocks : MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void NonblockingCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, blocks as in Variant 2.1
+    MPI_Comm comm = topology != nullptr ? topology->blocks : MPI_COMM_WORLD;
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(totalSize, P, blockStart, blockSize);
+
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    BigNumber::Limb *carries = nullptr;
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", totalSize);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", totalSize);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+        carries = BufferPool::acquire<BigNumber::Limb>(P);
+    }
+    Benchmark::lap(Benchmark::READ);
+
+    // chunk k of a block of size limbs: [size * k / chunks, size * (k + 1) / chunks)
+    int *counts = BufferPool::acquire<int>((long long) chunks * P);
+    int *displacements = BufferPool::acquire<int>((long long) chunks * P);
+    for (int k = 0; k < chunks; k++) {
+        for (int pid = 0; pid < P; pid++) {
+            const int low = (int) ((long long) blockSize[pid] * k / chunks);
+            const int high = (int) ((long long) blockSize[pid] * (k + 1) / chunks);
+            counts[k * P + pid] = high - low;
+            displacements[k * P + pid] = blockStart[pid] + low;
+        }
+    }
+
+    const int batchSize = blockSize[rank];
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    // two scatters per chunk, then one gather per chunk and the gather of the block carries
+    MPI_Request *scatters = BufferPool::acquire<MPI_Request>(2 * chunks);
+    MPI_Request *gathers = BufferPool::acquire<MPI_Request>(chunks + 1);
+
+    // toate scatter-ele pornesc deodata, fiecare bucata se aduna cand ajunge
+    const double posted = MPI_Wtime();
+    double waited = 0;
+    for (int k = 0; k < chunks; k++) {
+        const int offset = displacements[k * P + rank] - blockStart[rank];
+        MPI_Iscatterv(firstNumber, counts + k * P, displacements + k * P, MPI_LIMB,
+                      first_loc + offset, counts[k * P + rank], MPI_LIMB, 0, comm, &scatters[2 * k]);
+        MPI_Iscatterv(secondNumber, counts + k * P, displacements + k * P, MPI_LIMB,
+                      second_loc + offset, counts[k * P + rank], MPI_LIMB, 0, comm, &scatters[2 * k + 1]);
+    }
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    BigNumber::Limb carry = 0;
+    for (int k = 0; k < chunks; k++) {
+        const int offset = displacements[k * P + rank] - blockStart[rank];
+        const int count = counts[k * P + rank];
+        double begin = MPI_Wtime();
+        MPI_Waitall(2, scatters + 2 * k, MPI_STATUSES_IGNORE);
+        waited += MPI_Wtime() - begin;
+        Benchmark::lap(Benchmark::DISTRIBUTE);
+
+        carry = BigNumber::sum(first_loc + offset, second_loc + offset, result_loc + offset, count, carry);
+        Benchmark::lap(Benchmark::COMPUTE);
+        MPI_Igatherv(result_loc + offset, count, MPI_LIMB, result, counts + k * P, displacements + k * P,
+                     MPI_LIMB, 0, comm, &gathers[k]);
+        // collectivele inca deschise avanseaza doar in apeluri MPI
+        int done;
+        MPI_Testall(k + 1, gathers, &done, MPI_STATUSES_IGNORE);
+        if (k + 1 < chunks) {
+            MPI_Testall(2 * (chunks - k - 1), scatters + 2 * (k + 1), &done, MPI_STATUSES_IGNORE);
+        }
+        Benchmark::lap(Benchmark::GATHER);
+    }
+    MPI_Igather(&carry, 1, MPI_LIMB, carries, 1, MPI_LIMB, 0, comm, &gathers[chunks]);
+    double begin = MPI_Wtime();
+    MPI_Waitall(chunks + 1, gathers, MPI_STATUSES_IGNORE);
+    waited += MPI_Wtime() - begin;
+    const double inFlight = MPI_Wtime() - posted;
+    Benchmark::lap(Benchmark::GATHER);
+
+    Benchmark::overlap(inFlight, waited);
+    if (!Benchmark::measuring()) {
+        double local[2] = {inFlight, waited};
+        double total[2] = {0, 0};
+        MPI_Reduce(local, total, 2, MPI_DOUBLE, MPI_SUM, 0, comm);
+        if (rank == 0 && total[0] > 0) {
+            cout << fixed << setprecision(6) << "Hidden communication: " << (total[0] - total[1]) / P << "s of "
+                 << total[0] / P << "s in flight per process (" << setprecision(1)
+                 << 100 * (total[0] - total[1]) / total[0] << "%)" << defaultfloat << endl;
+        }
+    }
+
+    if (rank == 0) {
+        // carry-ul intra in fiecare bloc, ramane doar daca a trecut prin tot blocul
+        BigNumber::Limb incoming = 0;
+        for (int pid = 0; pid < P; pid++) {
+            BigNumber::passCarry(result + blockStart[pid], blockSize[pid], incoming);
+            incoming += carries[pid];
+        }
+        Benchmark::lap(Benchmark::CARRY);
+
+        ofstream outNb("resultNonblocking.txt");
+        BigNumber::writeDigits(outNb, result, totalSize, N_Max);
+        if (Checksum::enabled) {
+            Checksum::write("resultNonblocking.txt", Checksum::add(Checksum::hash(result, totalSize, 0),
+                                                                   Checksum::hash(&incoming, 1, totalSize)));
+        }
+        const BigNumber::Limb final_carry = BigNumber::overflowDigit(totalSize > 0 ? result[totalSize - 1] : 0,
+                                                                     N_Max, incoming);
+        if (final_carry > 0) {
+            outNb << final_carry << "\n";
+        }
+        outNb.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+        BufferPool::release(carries);
+    }
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(counts);
+    BufferPool::release(displacements);
+    BufferPool::release(scatters);
+    BufferPool::release(gathers);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
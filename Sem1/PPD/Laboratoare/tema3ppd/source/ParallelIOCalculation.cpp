@@ -0,0 +1,94 @@
+#include "../header/ParallelIOCalculation.h"
+#include <mpi.h>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/LookaheadCalculation.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+void ParallelIOCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void ParallelIOCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, no padding
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    const int dimension = totalSize / P;
+    const int extra = totalSize % P;
+    const int batchSize = dimension + (rank < extra);
+    const int startPoint = rank * dimension + (rank < extra ? rank : extra);
+
+    // fiecare proces citeste direct portiunea sa din fisiere
+    BigNumber::Limb *firstNumber = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *secondNumber = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    GenerateNumber::readNumberBlockAll(MPI_COMM_WORLD, "firstNumber.bin", startPoint, batchSize, firstNumber);
+    GenerateNumber::readNumberBlockAll(MPI_COMM_WORLD, "secondNumber.bin", startPoint, batchSize, secondNumber);
+    Benchmark::lap(Benchmark::READ);
+
+    const BigNumber::Limb generate = BigNumber::sum(firstNumber, secondNumber, result, batchSize);
+    const int run = (int) BigNumber::carryRun(result, batchSize);
+    const bool propagate = run == batchSize;
+    Benchmark::lap(Benchmark::COMPUTE);
+    const BigNumber::Limb incoming = LookaheadCalculation::incomingCarry(generate, propagate, MPI_COMM_WORLD);
+    BigNumber::Limb carry = generate;
+    if (incoming) {
+        carry += propagate;
+        BigNumber::selectCarry(result, batchSize, run);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultParallelIO.txt", result, batchSize, startPoint, carry, rank == P - 1, MPI_COMM_WORLD);
+    }
+
+    // fiecare cifra ocupa exact 2 octeti ("d "), deci fiecare proces isi scrie singur portiunea
+    const long long firstDigit = (long long) startPoint * BigNumber::DIGITS_PER_LIMB;
+    const int digits = firstDigit < N_Max ? (int) min<long long>(N_Max - firstDigit, (long long) batchSize * BigNumber::DIGITS_PER_LIMB) : 0;
+    char *buffer = BufferPool::acquire<char>(2 * digits + 1);
+    const int length = (int) BigNumber::formatDigits(result, batchSize, digits, buffer);
+
+    MPI_File file;
+    const bool opened = MPI_File_open(MPI_COMM_WORLD, "resultParallelIO.txt", MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                      MPI_INFO_NULL, &file) == MPI_SUCCESS;
+    if (opened) {
+        MPI_File_set_size(file, 0);
+        MPI_File_write_at_all(file, 2 * firstDigit, buffer, length, MPI_CHAR, MPI_STATUS_IGNORE);
+    } else if (rank == 0) {
+        cerr << "Result file could not be opened" << endl;
+    }
+
+    // procesul cu ultimul limb trimite cifra de overflow, master o scrie la final
+    // (si cand fisierul nu s-a deschis, ca Send/Recv sa ramana pereche)
+    const int topRank = dimension > 0 ? P - 1 : max(totalSize - 1, 0);
+    BigNumber::Limb overflow = 0;
+    if (rank == topRank) {
+        const BigNumber::Limb topLimb = batchSize > 0 ? result[batchSize - 1] : 0;
+        overflow = BigNumber::overflowDigit(topLimb, N_Max, carry);
+        if (topRank != 0) {
+            MPI_Send(&overflow, 1, MPI_LIMB, 0, 5, MPI_COMM_WORLD);
+        }
+    }
+    if (rank == 0) {
+        if (topRank != 0) {
+            MPI_Recv(&overflow, 1, MPI_LIMB, topRank, 5, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+        if (opened && overflow > 0) {
+            const char digit = (char) ('0' + overflow);
+            MPI_File_write_at(file, 2 * (MPI_Offset) N_Max, &digit, 1, MPI_CHAR, MPI_STATUS_IGNORE);
+        }
+    }
+    if (opened) {
+        MPI_File_close(&file);
+    }
+    Benchmark::lap(Benchmark::WRITE);
+
+    BufferPool::release(buffer);
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(result);
+}
@@ -0,0 +1,95 @@
+#include "../header/ReductionCalculation.h"
+#include <mpi.h>
+#include <fstream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+
+using namespace std;
+
+vector<string> ReductionCalculation::readOperandList(const string &listFile) {
+    vector<string> files;
+    ifstream in(listFile);
+    if (!in) {
+        cerr << "Operand list could not be opened" << endl;
+        return files;
+    }
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty()) {
+            files.push_back(line);
+        }
+    }
+    return files;
+}
+
+long long ReductionCalculation::resultSize(const long long numberOfDigits, long long count) {
+    // the sum has at most numberOfDigits + (digits of count) digits
+    long long digits = numberOfDigits;
+    while (count > 0) {
+        digits++;
+        count /= 10;
+    }
+    // at least one limb, the sum of no operands is 0
+    return digits > 0 ? BigNumber::limbCount(digits) : 1;
+}
+
+void ReductionCalculation::writeSum(const string &fileName, const BigNumber::Limb *number, const long long size) {
+    long long top = size - 1;
+    while (top > 0 && number[top] == 0) {
+        top--;
+    }
+    long long numberOfDigits = top * BigNumber::DIGITS_PER_LIMB + 1;
+    for (BigNumber::Limb value = number[top] / 10; value > 0; value /= 10) {
+        numberOfDigits++;
+    }
+    ofstream out(fileName);
+    BigNumber::writeDigits(out, number, size, numberOfDigits);
+}
+
+void ReductionCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void ReductionCalculation::calculator(int rank) {
+    const int count = (int) operandFiles.size();
+    long long maxDigits = 0;
+    for (const string &fileName: operandFiles) {
+        const long long digits = GenerateNumber::readNumberOfDigits(fileName);
+        if (digits > maxDigits) {
+            maxDigits = digits;
+        }
+    }
+    const int totalSize = (int) resultSize(maxDigits, count);
+    Benchmark::lap(Benchmark::READ);
+
+    // fiecare proces aduna operanzii rank, rank + P, ... fara transport intre limb-uri
+    BigNumber::Accumulator *accumulator = BufferPool::acquire<BigNumber::Accumulator>(totalSize);
+    for (int i = 0; i < totalSize; i++) {
+        accumulator[i] = 0;
+    }
+    for (int i = rank; i < count; i += P) {
+        BigNumber number = GenerateNumber::readNumber(operandFiles[i]);
+        BigNumber::accumulate(accumulator, number.data(), number.getSize());
+    }
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    // the word-wise sum of carry-save accumulators is again one, MPI_SUM is the combine op
+    BigNumber::Accumulator *total = rank == 0 ? BufferPool::acquire<BigNumber::Accumulator>(totalSize) : nullptr;
+    MPI_Reduce(accumulator, total, totalSize, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::GATHER);
+
+    if (rank == 0) {
+        BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+        BigNumber::normalize(total, totalSize, result);
+        Benchmark::lap(Benchmark::CARRY);
+        writeSum("resultReduce.txt", result, totalSize);
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+        BufferPool::release(total);
+    }
+    BufferPool::release(accumulator);
+}
@@ -0,0 +1,171 @@
+#include "../header/RmaCalculation.h"
+#include <mpi.h>
+#include <fstream>
+#include <thread>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+void RmaCalculation::run() {
+    int rank;
+    MPI_Comm_rank(topology != nullptr ? topology->blocks : MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+MPI_Win RmaCalculation::allocateCarryWindow(MPI_Comm comm, BigNumber::Limb *&slots, bool &shared) {
+    int P;
+    MPI_Comm_size(comm, &P);
+    MPI_Comm node;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+    int ranksOnNode;
+    MPI_Comm_size(node, &ranksOnNode);
+    MPI_Comm_free(&node);
+    shared = ranksOnNode == P;
+
+    MPI_Win window;
+    const MPI_Aint bytes = SLOTS * sizeof(BigNumber::Limb);
+    if (shared) {
+        MPI_Win_allocate_shared(bytes, sizeof(BigNumber::Limb), MPI_INFO_NULL, comm, &slots, &window);
+    } else {
+        MPI_Win_allocate(bytes, sizeof(BigNumber::Limb), MPI_INFO_NULL, comm, &slots, &window);
+    }
+    for (int slot = 0; slot < SLOTS; slot++) {
+        slots[slot] = 0;
+    }
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+    // no carry may be put before every process has emptied its slots
+    MPI_Win_sync(window);
+    MPI_Barrier(comm);
+    return window;
+}
+
+void RmaCalculation::putCarry(MPI_Win window, const bool shared, const int target, const Slot slot,
+                              const BigNumber::Limb carry) {
+    const BigNumber::Limb value = carry + 1;
+    if (shared) {
+        MPI_Put(&value, 1, MPI_LIMB, target, slot, 1, MPI_LIMB, window);
+    } else {
+        // atomic, like the MPI_Fetch_and_op the target polls with
+        MPI_Accumulate(&value, 1, MPI_LIMB, target, slot, 1, MPI_LIMB, MPI_REPLACE, window);
+    }
+    MPI_Win_flush(target, window);
+}
+
+BigNumber::Limb RmaCalculation::waitCarry(MPI_Win window, const bool shared, BigNumber::Limb *slots, const int rank,
+                                          const Slot slot) {
+    const volatile BigNumber::Limb *value = slots + slot;
+    const BigNumber::Limb none = 0;
+    BigNumber::Limb current = 0;
+    while (true) {
+        if (shared) {
+            // the store of the previous process is visible after the memory barrier
+            MPI_Win_sync(window);
+            current = *value;
+        } else {
+            // atomic read of the own slot, also drives the progress of the incoming update
+            MPI_Fetch_and_op(&none, &current, MPI_LIMB, rank, slot, MPI_NO_OP, window);
+            MPI_Win_flush(rank, window);
+        }
+        if (current != 0) {
+            return current - 1;
+        }
+        // with more processes than cores the previous process needs this core
+        this_thread::yield();
+    }
+}
+
+void RmaCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, blocks as in Variant 2.1
+    MPI_Comm comm = topology != nullptr ? topology->blocks : MPI_COMM_WORLD;
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(totalSize, P, blockStart, blockSize);
+
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    int sizes[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", 0, &sizes[0]);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", 0, &sizes[1]);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    MPI_Bcast(sizes, 2, MPI_INT, 0, comm);
+    BigNumber::Limb *slots = nullptr;
+    bool shared = false;
+    MPI_Win window = allocateCarryWindow(comm, slots, shared);
+    Benchmark::lap(Benchmark::READ);
+
+    const int batchSize = blockSize[rank];
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    if (topology != nullptr) {
+        topology->scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc);
+        topology->scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc);
+    } else {
+        ScattervCalculation::scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc, comm);
+        ScattervCalculation::scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc, comm);
+    }
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    BigNumber::Limb carry = BigNumber::sum(first_loc, second_loc, result_loc, batchSize);
+    // carry-select ca in Variant 1.1: carry-ul de iesire se stie imediat ce soseste cel de intrare
+    const int run = (int) BigNumber::carryRun(result_loc, batchSize);
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    BigNumber::Limb incoming = 0;
+    if (rank > 0) {
+        incoming = waitCarry(window, shared, slots, rank, INCOMING);
+        if (incoming > 0 && run == batchSize) {
+            carry += incoming;
+        }
+    }
+    // carry-ul se scrie direct in fereastra procesului urmator, ultimul il scrie la master
+    if (rank < P - 1) {
+        putCarry(window, shared, rank + 1, INCOMING, carry);
+    } else if (P > 1) {
+        putCarry(window, shared, 0, FINAL, carry);
+    }
+    if (incoming > 0) {
+        BigNumber::selectCarry(result_loc, batchSize, run);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultRma.txt", result_loc, batchSize, blockStart[rank], carry, rank == P - 1, comm);
+    }
+
+    if (topology != nullptr) {
+        topology->gatherBlocks(result_loc, blockStart, blockSize, result);
+    } else {
+        MPI_Gatherv(result_loc, batchSize, MPI_LIMB, result, blockSize, blockStart, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::GATHER);
+    if (rank == 0) {
+        ofstream outR("resultRma.txt");
+        BigNumber::writeDigits(outR, result, totalSize, N_Max);
+        BigNumber::Limb final_carry = P > 1 ? waitCarry(window, shared, slots, 0, FINAL) : carry;
+        final_carry = BigNumber::overflowDigit(totalSize > 0 ? result[totalSize - 1] : 0, N_Max, final_carry);
+        if (final_carry > 0) {
+            outR << final_carry << "\n";
+        }
+        outR.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+    }
+    MPI_Win_unlock_all(window);
+    MPI_Win_free(&window);
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
@@ -3,6 +3,28 @@
 #include <fstream>
 
 #include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+namespace {
+    // the block of a process in both operands: dimension limbs of the first number and the same
+    // limbs of the second one, relative to first; the extent is one block, so block k of the
+    // scatter is the k-th block of both numbers
+    MPI_Datatype operandPair(BigNumber::Limb *first, BigNumber::Limb *second, const int dimension) {
+        MPI_Aint firstAddress, secondAddress;
+        MPI_Get_address(first, &firstAddress);
+        MPI_Get_address(second, &secondAddress);
+        const int lengths[2] = {dimension, dimension};
+        const MPI_Aint displacements[2] = {0, MPI_Aint_diff(secondAddress, firstAddress)};
+        MPI_Datatype blocks, pair;
+        MPI_Type_create_hindexed(2, lengths, displacements, MPI_LIMB, &blocks);
+        MPI_Type_create_resized(blocks, 0, (MPI_Aint) dimension * sizeof(BigNumber::Limb), &pair);
+        MPI_Type_free(&blocks);
+        MPI_Type_commit(&pair);
+        return pair;
+    }
+}
 
 void ScatterCalculation::run() {
     int rank;
@@ -11,76 +33,82 @@ void ScatterCalculation::run() {
 }
 
 void ScatterCalculation::calculator(int rank) {
-    const int totalSize = N_Max % P == 0 ? N_Max : N_Max + (P - (N_Max % P));
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits
+    const int size = (int) BigNumber::limbCount(N_Max);
+    const int totalSize = size % P == 0 ? size : size + (P - (size % P));
     const int dimension = totalSize / P;
-    int *firstNumber = nullptr;
-    int *secondNumber = nullptr;
-    int *result = nullptr;
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", totalSize);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", totalSize);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    Benchmark::lap(Benchmark::READ);
+    // both operands of a process arrive in one buffer, the second right after the first
+    BigNumber::Limb *operands_loc = BufferPool::acquire<BigNumber::Limb>(2 * dimension);
+    BigNumber::Limb *first_loc = operands_loc;
+    BigNumber::Limb *second_loc = operands_loc + dimension;
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(dimension);
+    // se distribuie simultan numerele la fiecare proces, intr-un singur scatter
+    MPI_Datatype pair = MPI_LIMB;
+    int pairCount = 2 * dimension;
+    if (rank == 0) {
+        pair = operandPair(firstNumber, secondNumber, dimension);
+        pairCount = 1;
+    }
+    MPI_Scatter(firstNumber, pairCount, pair, operands_loc, 2 * dimension, MPI_LIMB, 0, MPI_COMM_WORLD);
     if (rank == 0) {
-        firstNumber = GenerateNumber::readNumberP("firstNumber.txt", totalSize);
-        secondNumber = GenerateNumber::readNumberP("secondNumber.txt", totalSize);
-        result = new int[totalSize];
+        MPI_Type_free(&pair);
     }
-    int *first_loc = new int[dimension];
-    int *second_loc = new int[dimension];
-    int *result_loc = new int[dimension];
-    // se distribuie simultan numerele la fiecare proces
-    MPI_Scatter(firstNumber, dimension, MPI_INT, first_loc, dimension, MPI_INT, 0, MPI_COMM_WORLD); // se distribuie simultan 
-    MPI_Scatter(secondNumber, dimension, MPI_INT, second_loc, dimension, MPI_INT, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::DISTRIBUTE);
 
-    int carry = sum(first_loc, second_loc, result_loc, dimension);// suma portiunii sale
+    BigNumber::Limb carry = BigNumber::sum(first_loc, second_loc, result_loc, dimension);// suma portiunii sale
+    Benchmark::lap(Benchmark::COMPUTE);
 
     if (rank > 0) {
-        int receivedCarry;
-        MPI_Recv(&receivedCarry, 1,MPI_INT, rank - 1, 4,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+        BigNumber::Limb receivedCarry;
+        MPI_Recv(&receivedCarry, 1,MPI_LIMB, rank - 1, 4,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
         if (receivedCarry > 0) {
-            passCarry(result_loc, dimension, receivedCarry);
+            BigNumber::passCarry(result_loc, dimension, receivedCarry);
             carry += receivedCarry; // fiecare proces caculeaza suma portiunii sale si o trimite la procesul urmator
         }
     }
     // worker trimite carry la procesul urmator
     if (rank < (P - 1)) {
-        MPI_Send(&carry, 1,MPI_INT, rank + 1, 4,MPI_COMM_WORLD);
+        MPI_Send(&carry, 1,MPI_LIMB, rank + 1, 4,MPI_COMM_WORLD);
     } else if (rank == P - 1 && P > 1) { // daca este ultimul proces, trimite carry la master
-        MPI_Send(&carry, 1, MPI_INT, 0, 5, MPI_COMM_WORLD);
+        MPI_Send(&carry, 1, MPI_LIMB, 0, 5, MPI_COMM_WORLD);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultScatter.txt", result_loc, dimension, (long long) rank * dimension, carry, rank == P - 1, MPI_COMM_WORLD);
     }
     // se colecteaza rezultatele la master
-    MPI_Gather(result_loc, dimension, MPI_INT, result, dimension, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gather(result_loc, dimension, MPI_LIMB, result, dimension, MPI_LIMB, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::GATHER);
     // se scrie rezultatul la master
     if (rank == 0) {
         ofstream outS("resultScatter.txt");
-        for (int i = 0; i < N_Max; i++) {
-            outS << result[i] << " ";
-        }
-        int final_carry = 0;
+        BigNumber::writeDigits(outS, result, size, N_Max);
+        BigNumber::Limb final_carry = 0;
 
-        MPI_Recv(&final_carry, 1, MPI_INT, P - 1, 5, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Recv(&final_carry, 1, MPI_LIMB, P - 1, 5, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        // with padding the carry out of the number lands in the first padded limb
+        if (size < totalSize) {
+            final_carry = result[size];
+        }
+        final_carry = BigNumber::overflowDigit(size > 0 ? result[size - 1] : 0, N_Max, final_carry);
         if (final_carry > 0) {
             outS << final_carry << "\n";
         }
         outS.close();
-        delete[] firstNumber;
-        delete[] secondNumber;
-        delete[] result;
-    }
-    delete[] first_loc;
-    delete[] second_loc;
-    delete[] result_loc;
-}
-
-int ScatterCalculation::sum(const int *firstNumber, const int *secondNumber, int *result, const int size) {
-    int carry = 0;
-    for (int i = 0; i < size; i++) {
-        result[i] = (firstNumber[i] + secondNumber[i] + carry) % 10;
-        carry = (firstNumber[i] + secondNumber[i] + carry) / 10;
-    }
-    return carry;
-}
-
-void ScatterCalculation::passCarry(int *number, const int size, int &carry) {
-    for (int i = 0; i < size; i++) {
-        const int value = number[i] + carry;
-        number[i] = value % 10;
-        carry = value / 10;
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(firstNumber);
+        BufferPool::release(secondNumber);
+        BufferPool::release(result);
     }
+    BufferPool::release(operands_loc);
+    BufferPool::release(result_loc);
 }
@@ -0,0 +1,160 @@
+#include "../header/ScattervCalculation.h"
+#include <mpi.h>
+#include <fstream>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+void ScattervCalculation::run() {
+    int rank;
+    MPI_Comm_rank(topology != nullptr ? topology->blocks : MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void ScattervCalculation::blockLayout(const int totalSize, const int P, int *blockStart, int *blockSize) {
+    const int dimension = totalSize / P;
+    const int extra = totalSize % P;
+    for (int pid = 0; pid < P; pid++) {
+        blockSize[pid] = dimension + (pid < extra);
+        blockStart[pid] = pid * dimension + (pid < extra ? pid : extra);
+    }
+}
+
+void ScattervCalculation::operandLayout(const int *blockStart, const int *blockSize, const int P, const int size,
+                                        int *counts, int *displacements) {
+    for (int pid = 0; pid < P; pid++) {
+        const int available = size - blockStart[pid];
+        counts[pid] = available <= 0 ? 0 : (available < blockSize[pid] ? available : blockSize[pid]);
+        displacements[pid] = counts[pid] > 0 ? blockStart[pid] : 0;
+    }
+}
+
+void ScattervCalculation::scatterBlocks(const BigNumber::Limb *number, const int size, const int *blockStart,
+                                        const int *blockSize, BigNumber::Limb *local, MPI_Comm comm) {
+    int rank;
+    int P;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &P);
+    int *counts = BufferPool::acquire<int>(P);
+    int *displacements = BufferPool::acquire<int>(P);
+    operandLayout(blockStart, blockSize, P, size, counts, displacements);
+    MPI_Scatterv(number, counts, displacements, MPI_LIMB, local, counts[rank], MPI_LIMB, 0, comm);
+    for (int i = counts[rank]; i < blockSize[rank]; i++) {
+        local[i] = 0;
+    }
+    BufferPool::release(counts);
+    BufferPool::release(displacements);
+}
+
+void ScattervCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, blocks may be uneven
+    MPI_Comm comm = topology != nullptr ? topology->blocks : MPI_COMM_WORLD;
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    blockLayout(totalSize, P, blockStart, blockSize);
+
+    // doar master-ul are numerele, fiecare operand e trimis exact cat e de lung
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    int sizes[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", 0, &sizes[0]);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", 0, &sizes[1]);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    MPI_Bcast(sizes, 2, MPI_INT, 0, comm);
+    Benchmark::lap(Benchmark::READ);
+
+    int *firstCounts = BufferPool::acquire<int>(P);
+    int *firstDispls = BufferPool::acquire<int>(P);
+    int *secondCounts = BufferPool::acquire<int>(P);
+    int *secondDispls = BufferPool::acquire<int>(P);
+    operandLayout(blockStart, blockSize, P, sizes[0], firstCounts, firstDispls);
+    operandLayout(blockStart, blockSize, P, sizes[1], secondCounts, secondDispls);
+
+    const int batchSize = blockSize[rank];
+    int firstCount = firstCounts[rank];
+    int secondCount = secondCounts[rank];
+    BigNumber::Limb *first_loc;
+    BigNumber::Limb *second_loc;
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    if (topology != nullptr) {
+        // prin leader-ul nodului, blocurile vin completate cu 0
+        firstCount = secondCount = batchSize;
+        first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+        second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+        topology->scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc);
+        topology->scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc);
+    } else {
+        first_loc = BufferPool::acquire<BigNumber::Limb>(firstCount);
+        second_loc = BufferPool::acquire<BigNumber::Limb>(secondCount);
+        MPI_Scatterv(firstNumber, firstCounts, firstDispls, MPI_LIMB,
+                     first_loc, firstCount, MPI_LIMB, 0, comm);
+        MPI_Scatterv(secondNumber, secondCounts, secondDispls, MPI_LIMB,
+                     second_loc, secondCount, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    // limb-urile lipsa ale operandului mai scurt sunt 0
+    BigNumber::Limb carry = BigNumber::sum(first_loc, firstCount, second_loc, secondCount, result_loc, batchSize);
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    if (rank > 0) {
+        BigNumber::Limb receivedCarry;
+        MPI_Recv(&receivedCarry, 1, MPI_LIMB, rank - 1, 4, comm, MPI_STATUS_IGNORE);
+        if (receivedCarry > 0) {
+            BigNumber::passCarry(result_loc, batchSize, receivedCarry);
+            carry += receivedCarry;
+        }
+    }
+    // worker trimite carry la procesul urmator
+    if (rank < (P - 1)) {
+        MPI_Send(&carry, 1, MPI_LIMB, rank + 1, 4, comm);
+    } else if (P > 1) { // daca este ultimul proces, trimite carry la master
+        MPI_Send(&carry, 1, MPI_LIMB, 0, 5, comm);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+    if (Checksum::enabled) {
+        Checksum::reduce("resultScatterv.txt", result_loc, batchSize, blockStart[rank], carry, rank == P - 1, comm);
+    }
+
+    // se colecteaza exact totalSize limb-uri
+    if (topology != nullptr) {
+        topology->gatherBlocks(result_loc, blockStart, blockSize, result);
+    } else {
+        MPI_Gatherv(result_loc, batchSize, MPI_LIMB, result, blockSize, blockStart, MPI_LIMB, 0, comm);
+    }
+    Benchmark::lap(Benchmark::GATHER);
+    if (rank == 0) {
+        ofstream outSv("resultScatterv.txt");
+        BigNumber::writeDigits(outSv, result, totalSize, N_Max);
+        BigNumber::Limb final_carry = carry;
+        if (P > 1) {
+            MPI_Recv(&final_carry, 1, MPI_LIMB, P - 1, 5, comm, MPI_STATUS_IGNORE);
+        }
+        final_carry = BigNumber::overflowDigit(totalSize > 0 ? result[totalSize - 1] : 0, N_Max, final_carry);
+        if (final_carry > 0) {
+            outSv << final_carry << "\n";
+        }
+        outSv.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+    }
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(firstCounts);
+    BufferPool::release(firstDispls);
+    BufferPool::release(secondCounts);
+    BufferPool::release(secondDispls);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
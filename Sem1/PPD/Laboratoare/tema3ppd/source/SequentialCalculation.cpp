@@ -1,42 +1,70 @@
 #include "../header/SequentialCalculation.h"
-int* SequentialCalculation::calculate() {
-	int dim,minDim;
-	if (N1 > N2) {
-		dim = N1 +1;
-		minDim = N2;
+BigNumber SequentialCalculation::calculate() {
+	long long dim = numberOne.getNumberOfDigits();
+	if (numberTwo.getNumberOfDigits() > dim) {
+		dim = numberTwo.getNumberOfDigits();
 	}
-	else {
-		dim = N2 +1;
-		minDim = N1;
+
+	// one spare digit (and limb) for the final carry
+	BigNumber result(dim + 1);
+	const long long size = BigNumber::limbCount(dim);
+	const BigNumber::Limb carry = BigNumber::sum(numberOne.data(), numberOne.getSize(),
+	                                             numberTwo.data(), numberTwo.getSize(), result.data(), size);
+	if (carry) {
+		result.data()[size] = carry;
 	}
 
-	int* result = new int[dim];
-	int carry = 0; 
-	for(int i = 0; i <minDim; i++) {
-		result[i] =( numberOne[i] + numberTwo[i] + carry) % 10;
-		carry = (numberOne[i] + numberTwo[i] + carry) / 10;
+	if (BigNumber::overflowDigit(size > 0 ? result.data()[size - 1] : 0, dim, carry) == 0) {
+		result.resize(dim);
 	}
+	return result;
+}
 
-	if (N1 > minDim) {
-		for (int i = minDim; i < N1; i++) {
-			result[i] = (numberOne[i] + carry) % 10;
-			carry = (numberOne[i] + carry) / 10;
-		}
-		if (carry) {
-			result[dim - 1] = carry;
-		}
+BigNumber SequentialCalculation::subtract(bool &negative) {
+	long long dim = numberOne.getNumberOfDigits();
+	if (numberTwo.getNumberOfDigits() > dim) {
+		dim = numberTwo.getNumberOfDigits();
 	}
-	else if (N2 > minDim) {
-		for (int i = minDim; i < N2; i++) {
-			result[i] = (numberTwo[i] + carry) % 10;
-			carry = (numberTwo[i] + carry) / 10;
-		}
-		if (carry) {
-			result[dim - 1] = carry;
-		}
+	// both operands on the same number of limbs
+	BigNumber first = numberOne;
+	BigNumber second = numberTwo;
+	first.resize(dim);
+	second.resize(dim);
+
+	negative = BigNumber::compare(first.data(), second.data(), first.getSize()) < 0;
+	BigNumber result(dim);
+	if (negative) {
+		BigNumber::subtract(second.data(), first.data(), result.data(), result.getSize());
+	} else {
+		BigNumber::subtract(first.data(), second.data(), result.data(), result.getSize());
 	}
-	else if (carry) {
-			result[dim - 1] = carry;
+	return result;
+}
+
+int SequentialCalculation::compare() {
+	bool negative;
+	BigNumber difference = subtract(negative);
+	if (negative) {
+		return -1;
+	}
+	for (long long i = 0; i < difference.getSize(); i++) {
+		if (difference.data()[i] != 0) {
+			return 1;
 		}
+	}
+	return 0;
+}
+
+BigNumber SequentialCalculation::multiply() {
+	BigNumber result(numberOne.getNumberOfDigits() + numberTwo.getNumberOfDigits());
+	vector<BigNumber::Limb> product(numberOne.getSize() + numberTwo.getSize());
+	BigNumber::multiply(numberOne.data(), numberOne.getSize(), numberTwo.data(), numberTwo.getSize(), product.data());
+	for (long long i = 0; i < result.getSize(); i++) {
+		result.data()[i] = product[i];
+	}
+	// the product has as many digits as both operands together, or one less
+	if (result.getNumberOfDigits() > 1 && result.digit(result.getNumberOfDigits() - 1) == 0) {
+		result.resize(result.getNumberOfDigits() - 1);
+	}
 	return result;
-	}
\ No newline at end of file
+}
@@ -0,0 +1,183 @@
+#include "../header/Server.h"
+#include <mpi.h>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../header/BigNumber.h"
+#include "../header/GenerateNumber.h"
+
+using namespace std;
+
+namespace {
+    // job broadcast to every process: variant (-1 stops the server), the sizes of the operands
+    // to generate (0 reuses the files) and the longest operand
+    struct Job {
+        long long variant;
+        long long N1;
+        long long N2;
+        long long N_Max;
+    };
+
+    bool socketAddress(const string &socketPath, sockaddr_un &address) {
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            cerr << "Socket path too long" << endl;
+            return false;
+        }
+        strcpy(address.sun_path, socketPath.c_str());
+        return true;
+    }
+
+    // one line, without the '\n'
+    string readLine(const int fd) {
+        string line;
+        char c;
+        while (read(fd, &c, 1) == 1 && c != '\n') {
+            line += c;
+        }
+        return line;
+    }
+
+    void writeLine(const int fd, const string &line) {
+        const string message = line + "\n";
+        // MSG_NOSIGNAL: a client that already left must not kill the server
+        send(fd, message.c_str(), message.size(), MSG_NOSIGNAL);
+    }
+
+    // parses a job line on process 0, the operands are generated afterwards by every process
+    Job parseJob(const string &line, const int processes, string &error) {
+        Job job = {-1, 0, 0, 0};
+        if (line == "quit") {
+            return job;
+        }
+        stringstream in(line);
+        long long N1 = 0, N2 = 0;
+        if (!(in >> job.variant)) {
+            error = "expected \"<variant> [N1 N2]\" or \"quit\"";
+            return job;
+        }
+        if (in >> N1 >> N2) {
+            if (N1 <= 0 || N2 <= 0) {
+                error = "sizes must be positive";
+                return job;
+            }
+            job.N1 = N1;
+            job.N2 = N2;
+        } else {
+            N1 = GenerateNumber::readNumberOfDigits("firstNumber.bin");
+            N2 = GenerateNumber::readNumberOfDigits("secondNumber.bin");
+            if (N1 < 0 || N2 < 0) {
+                error = "no operand files, send the sizes";
+                return job;
+            }
+        }
+        job.N_Max = N1 > N2 ? N1 : N2;
+        if (job.variant != 0 && job.variant != 6 && !BigNumber::fitsParallel(job.N_Max, processes)) {
+            error = "numbers too large for the parallel variants, run variant 0";
+        }
+        return job;
+    }
+}
+
+void Server::serve(const string &socketPath, const GenerateNumber::Options &generate,
+                   const function<bool(int, long long)> &execute) {
+    int rank, P;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &P);
+
+    int listener = -1;
+    if (rank == 0) {
+        sockaddr_un address;
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener >= 0 && socketAddress(socketPath, address)) {
+            unlink(socketPath.c_str());
+            if (bind(listener, (sockaddr *) &address, sizeof(address)) != 0 || listen(listener, 16) != 0) {
+                close(listener);
+                listener = -1;
+            }
+        }
+        if (listener < 0) {
+            cerr << "Socket could not be opened" << endl;
+        } else {
+            cout << "Serving on " << socketPath << endl;
+        }
+    }
+    MPI_Bcast(&listener, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (listener < 0) {
+        return;
+    }
+
+    // procesele raman pornite, doar job-ul circula la fiecare cerere
+    while (true) {
+        Job job = {0, 0, 0, 0};
+        int client = -1;
+        if (rank == 0) {
+            string error;
+            while (true) {
+                client = accept(listener, nullptr, nullptr);
+                if (client < 0) {
+                    continue;
+                }
+                error.clear();
+                job = parseJob(readLine(client), P, error);
+                if (error.empty()) {
+                    break;
+                }
+                writeLine(client, "error " + error);
+                close(client);
+            }
+        }
+        MPI_Bcast(&job, 4, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+        if (job.variant < 0) {
+            if (rank == 0) {
+                writeLine(client, "ok bye");
+                close(client);
+            }
+            break;
+        }
+
+        const double start = MPI_Wtime();
+        if (job.N1 > 0) {
+            GenerateNumber::generateOperands(job.N1, job.N2, generate, MPI_COMM_WORLD);
+        }
+        const bool known = execute((int) job.variant, job.N_Max);
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (rank == 0) {
+            ostringstream reply;
+            if (known) {
+                reply << "ok " << MPI_Wtime() - start;
+            } else {
+                reply << "error unknown variant " << job.variant;
+            }
+            writeLine(client, reply.str());
+            close(client);
+        }
+    }
+
+    if (rank == 0) {
+        close(listener);
+        unlink(socketPath.c_str());
+    }
+}
+
+int Server::request(const string &socketPath, const string &job) {
+    sockaddr_un address;
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || !socketAddress(socketPath, address) || connect(fd, (sockaddr *) &address, sizeof(address)) != 0) {
+        cerr << "Socket could not be opened" << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+    writeLine(fd, job);
+    const string reply = readLine(fd);
+    close(fd);
+    cout << reply << endl;
+    return reply.rfind("ok", 0) == 0 ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 #include "../header/StandardCalculation.h"
 #include "mpi.h"
 #include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
 #include <fstream>
 
 using namespace std;
@@ -12,13 +15,20 @@ void StandardCalculation::run() {
 }
 
 void StandardCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    // optionally master also adds the first block
+    const int firstWorker = masterWorks ? 0 : 1;
+    const int workers = P - firstWorker;
 if (rank == 0) {
         ofstream out("result1.txt");
-        const int dimension = N_Max / (P - 1);
-        int extra = N_Max % (P - 1);
+        const int dimension = totalSize / workers;
+        int extra = totalSize % workers;
         int startPoint = 0;
+        BigNumber::Limb *ownOperands = nullptr;
+        int ownSize = 0;
 
-        for (int pid = 1; pid < P; pid++) {
+        for (int pid = firstWorker; pid < P; pid++) {
             int endPoint = startPoint + dimension;
             if (extra > 0) {
                 endPoint++;
@@ -26,23 +36,47 @@ if (rank == 0) {
             }
             int batchSize = endPoint - startPoint;
 
-            int *firstNumber = GenerateNumber::readNumberBlock("firstNumber.txt", startPoint, batchSize);
-            int *secondNumber = GenerateNumber::readNumberBlock("secondNumber.txt", startPoint, batchSize);
-
-            MPI_Send(firstNumber, batchSize, MPI_INT, pid, 0, MPI_COMM_WORLD);
-            MPI_Send(secondNumber, batchSize, MPI_INT, pid, 1, MPI_COMM_WORLD);
+            // ambii operanzi ai blocului intr-un singur buffer, pleaca intr-un singur mesaj
+            BigNumber::Limb *operands = BufferPool::acquire<BigNumber::Limb>(2 * batchSize);
+            GenerateNumber::readNumberBlock("firstNumber.bin", startPoint, batchSize, operands);
+            GenerateNumber::readNumberBlock("secondNumber.bin", startPoint, batchSize, operands + batchSize);
+            Benchmark::lap(Benchmark::READ);
 
             startPoint = endPoint;
+            if (pid == 0) {
+                // master-ul isi pastreaza primul bloc si il aduna dupa ce a trimis restul
+                ownOperands = operands;
+                ownSize = batchSize;
+                continue;
+            }
+
+            MPI_Send(operands, 2 * batchSize, MPI_LIMB, pid, 0, MPI_COMM_WORLD);
+            Benchmark::lap(Benchmark::DISTRIBUTE);
 
-             delete[] firstNumber;
-             delete[] secondNumber;
+            BufferPool::release(operands);
         }
 
 
-        extra = N_Max % (P - 1);
+        BigNumber::Limb *ownResult = nullptr;
+        BigNumber::Limb ownCarry = 0;
+        if (masterWorks) {
+            ownResult = BufferPool::acquire<BigNumber::Limb>(ownSize);
+            ownCarry = BigNumber::sum(ownOperands, ownOperands + ownSize, ownResult, ownSize);
+            Benchmark::lap(Benchmark::COMPUTE);
+            BufferPool::release(ownOperands);
+            // primul bloc nu are carry de intrare, il trimite direct urmatorului
+            if (P > 1) {
+                MPI_Send(&ownCarry, 1, MPI_LIMB, 1, 4, MPI_COMM_WORLD);
+            }
+            Benchmark::lap(Benchmark::CARRY);
+        }
+
+        extra = totalSize % workers;
         startPoint = 0;
+        BigNumber::Limb topLimb = 0;
+        uint64_t checksum = 0;
 
-        for (int pid = 1; pid < P; pid++) {
+        for (int pid = firstWorker; pid < P; pid++) {
             int endPoint = startPoint + dimension;
             if (extra > 0) {
                 endPoint++;
@@ -50,81 +84,82 @@ if (rank == 0) {
             }
             int batchSize = endPoint - startPoint;
 
-            int *result = new int[batchSize];
-            MPI_Recv(result, batchSize, MPI_INT, pid, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-            for (int i = 0; i < batchSize; i++) {
-                out << result[i] << " ";
+            BigNumber::Limb *result = ownResult;
+            if (pid != 0) {
+                // the last worker appends the carry out of the number to its block
+                result = BufferPool::acquire<BigNumber::Limb>(batchSize + 1);
+                MPI_Recv(result, batchSize + (pid == P - 1), MPI_LIMB, pid, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             }
+            Benchmark::lap(Benchmark::GATHER);
 
+            BigNumber::writeDigits(out, result, batchSize, N_Max - (long long) startPoint * BigNumber::DIGITS_PER_LIMB);
+            Benchmark::lap(Benchmark::WRITE);
+            if (batchSize > 0) {
+                topLimb = result[batchSize - 1];
+            }
+            if (Checksum::enabled) {
+                checksum = Checksum::add(checksum, Checksum::hash(result, batchSize, startPoint));
+            }
 
             if (pid == P - 1) {
-                int flag;
-                MPI_Recv(&flag, 1, MPI_INT, pid, 3, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                BigNumber::Limb flag = ownCarry;
+                if (pid != 0) {
+                    flag = result[batchSize];
+                }
+                checksum = Checksum::add(checksum, Checksum::hash(&flag, 1, totalSize));
+                flag = BigNumber::overflowDigit(topLimb, N_Max, flag);
                 if (flag != 0) {
                     out << flag;
                 }
             }
             startPoint = endPoint;
-            delete[] result;
+            BufferPool::release(result);
         }
         out.close();
+        if (Checksum::enabled) {
+            Checksum::write("result1.txt", checksum);
+        }
+        Benchmark::lap(Benchmark::WRITE);
     } else {
-        const int dimension = N_Max / (P - 1);
-        const int extra = N_Max % (P - 1);
-        const int batchSize = dimension + ((rank - 1) < extra);
-
-        int *firstNumber = new int[batchSize];
-        int *secondNumber = new int[batchSize];
-        // worker primese numerele de la master
-        MPI_Recv(firstNumber, batchSize,MPI_INT, 0, 0,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
-        MPI_Recv(secondNumber, batchSize,MPI_INT, 0, 1,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
-
-        int *result = new int[batchSize];
+        const int dimension = totalSize / workers;
+        const int extra = totalSize % workers;
+        const int batchSize = dimension + ((rank - firstWorker) < extra);
+
+        // worker primeste ambii operanzi intr-un singur mesaj, al doilea dupa primul
+        BigNumber::Limb *operands = BufferPool::acquire<BigNumber::Limb>(2 * batchSize);
+        MPI_Recv(operands, 2 * batchSize, MPI_LIMB, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const BigNumber::Limb *firstNumber = operands;
+        const BigNumber::Limb *secondNumber = operands + batchSize;
+        Benchmark::lap(Benchmark::DISTRIBUTE);
+
+        // one limb more for the carry out of the number
+        BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(batchSize + 1);
         // worker calculeaza suma portiunii sale
 
-        int carry = sum(firstNumber, secondNumber, result, batchSize);
+        BigNumber::Limb carry = BigNumber::sum(firstNumber, secondNumber, result, batchSize);
+        Benchmark::lap(Benchmark::COMPUTE);
 
         // worker primeste carry de la procesul anterior
-        if (rank > 1) {
-            int receivedCarry;
-            MPI_Recv(&receivedCarry, 1,MPI_INT, rank - 1, 4,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+        if (rank > firstWorker) {
+            BigNumber::Limb receivedCarry;
+            MPI_Recv(&receivedCarry, 1,MPI_LIMB, rank - 1, 4,MPI_COMM_WORLD,MPI_STATUS_IGNORE);
             if (receivedCarry > 0) {
-                passCarry(result, batchSize, receivedCarry);
+                BigNumber::passCarry(result, batchSize, receivedCarry);
                 carry+=receivedCarry;
             }
         }
         // worker trimite carry la procesul urmator
         if (rank < (P - 1)) {
-            MPI_Send(&carry, 1,MPI_INT, rank + 1, 4,MPI_COMM_WORLD);
-        }
-
-        // worker trimite rezultatul la master
-        MPI_Send(result, batchSize,MPI_INT, 0, 2,MPI_COMM_WORLD);
-        // worker trimite carry la master
-        if (rank == P - 1) { // daca este ultimul proces, trimite carry la master
-            MPI_Send(&carry, 1,MPI_INT, 0, 3,MPI_COMM_WORLD);
+            MPI_Send(&carry, 1,MPI_LIMB, rank + 1, 4,MPI_COMM_WORLD);
         }
+        Benchmark::lap(Benchmark::CARRY);
 
-        delete[] firstNumber;
-        delete[] secondNumber;
-        delete[] result;
-    }
-}
-
-int StandardCalculation::sum(const int *firstNumber, const int *secondNumber, int *result, const int size) {
-    int carry = 0;
-    for (int i = 0; i < size; i++) {
-        result[i] = (firstNumber[i] + secondNumber[i] + carry) % 10;
-        carry = (firstNumber[i] + secondNumber[i] + carry) / 10;
-    }
-    return carry;
-}
+        // worker trimite rezultatul la master, ultimul adauga carry-ul final in acelasi mesaj
+        result[batchSize] = carry;
+        MPI_Send(result, batchSize + (rank == P - 1), MPI_LIMB, 0, 2, MPI_COMM_WORLD);
+        Benchmark::lap(Benchmark::GATHER);
 
-void StandardCalculation::passCarry(int *number, const int size, int &carry) {
-    for (int i = 0; i < size; i++) {
-        const int value = number[i] + carry;
-        number[i] = value % 10;
-        carry = value / 10;
+        BufferPool::release(operands);
+        BufferPool::release(result);
     }
 }
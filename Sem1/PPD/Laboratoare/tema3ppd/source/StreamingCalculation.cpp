@@ -0,0 +1,66 @@
+#include "../header/StreamingCalculation.h"
+#include <algorithm>
+#include <fstream>
+#include "../header/GenerateNumber.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+bool StreamingCalculation::calculate() {
+	const long long firstDigits = GenerateNumber::readNumberOfDigits(firstFile);
+	const long long secondDigits = GenerateNumber::readNumberOfDigits(secondFile);
+	if (firstDigits < 0 || secondDigits < 0) {
+		cerr << "Number file could not be opened" << endl;
+		return false;
+	}
+	ofstream out(resultFile, ios::binary);
+	if (!out) {
+		cerr << "Number file could not be opened" << endl;
+		return false;
+	}
+	const long long dim = firstDigits > secondDigits ? firstDigits : secondDigits;
+	const long long size = BigNumber::limbCount(dim);
+	// the digit count is patched at the end if the sum gets one more digit
+	GenerateNumber::writeHeader(out, dim);
+
+	BigNumber::Limb *first = BufferPool::acquire<BigNumber::Limb>(windowSize);
+	BigNumber::Limb *second = BufferPool::acquire<BigNumber::Limb>(windowSize);
+	BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(windowSize);
+	uint8_t *digits = BufferPool::acquire<uint8_t>((long long) windowSize * BigNumber::DIGITS_PER_LIMB);
+	BigNumber::Limb carry = 0;
+	BigNumber::Limb topLimb = 0;
+	uint64_t checksum = 0;
+	for (long long offset = 0; offset < size; offset += windowSize) {
+		const int length = (int) min<long long>(windowSize, size - offset);
+		// only this window of each file is touched, digits past the end read as 0
+		GenerateNumber::readNumberBlock(firstFile, offset, length, first);
+		GenerateNumber::readNumberBlock(secondFile, offset, length, second);
+		carry = BigNumber::sum(first, second, result, length, carry);
+		topLimb = result[length - 1];
+		if (Checksum::enabled) {
+			checksum = Checksum::add(checksum, Checksum::hash(result, length, offset));
+		}
+
+		const long long count = min<long long>((long long) length * BigNumber::DIGITS_PER_LIMB,
+		                                       dim - offset * BigNumber::DIGITS_PER_LIMB);
+		BigNumber::unpackDigits(result, count, digits);
+		out.write(reinterpret_cast<const char *>(digits), count);
+	}
+
+	if (Checksum::enabled) {
+		Checksum::write(resultFile, Checksum::add(checksum, Checksum::hash(&carry, 1, size)));
+	}
+
+	const BigNumber::Limb overflow = BigNumber::overflowDigit(topLimb, dim, carry);
+	if (overflow != 0) {
+		const uint8_t digit = (uint8_t) overflow;
+		out.write(reinterpret_cast<const char *>(&digit), 1);
+		out.seekp(0);
+		GenerateNumber::writeHeader(out, dim + 1);
+	}
+
+	BufferPool::release(first);
+	BufferPool::release(second);
+	BufferPool::release(result);
+	BufferPool::release(digits);
+	return true;
+}
@@ -0,0 +1,83 @@
+#include "../header/SubtractionCalculation.h"
+#include <mpi.h>
+#include <fstream>
+#include <utility>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/ComparisonCalculation.h"
+#include "../header/LookaheadCalculation.h"
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+
+using namespace std;
+
+void SubtractionCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+void SubtractionCalculation::calculator(int rank) {
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    int *blockStart = BufferPool::acquire<int>(P);
+    int *blockSize = BufferPool::acquire<int>(P);
+    ScattervCalculation::blockLayout(totalSize, P, blockStart, blockSize);
+
+    BigNumber::Limb *firstNumber = nullptr;
+    BigNumber::Limb *secondNumber = nullptr;
+    BigNumber::Limb *result = nullptr;
+    int sizes[2] = {0, 0};
+    if (rank == 0) {
+        firstNumber = GenerateNumber::readNumberP("firstNumber.bin", 0, &sizes[0]);
+        secondNumber = GenerateNumber::readNumberP("secondNumber.bin", 0, &sizes[1]);
+        result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+    }
+    MPI_Bcast(sizes, 2, MPI_INT, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::READ);
+
+    const int batchSize = blockSize[rank];
+    BigNumber::Limb *first_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *second_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    BigNumber::Limb *result_loc = BufferPool::acquire<BigNumber::Limb>(batchSize);
+    ScattervCalculation::scatterBlocks(firstNumber, sizes[0], blockStart, blockSize, first_loc, MPI_COMM_WORLD);
+    ScattervCalculation::scatterBlocks(secondNumber, sizes[1], blockStart, blockSize, second_loc, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::DISTRIBUTE);
+
+    // se scade mereu numarul mai mic din cel mai mare, semnul se scrie la final
+    const int order = ComparisonCalculation::globalOrder(first_loc, second_loc, batchSize, blockStart[rank],
+                                                         MPI_COMM_WORLD);
+    const BigNumber::Limb *minuend = order < 0 ? second_loc : first_loc;
+    const BigNumber::Limb *subtrahend = order < 0 ? first_loc : second_loc;
+    const BigNumber::Limb generate = BigNumber::subtract(minuend, subtrahend, result_loc, batchSize);
+    // un bloc de zerouri transmite mai departe imprumutul primit
+    const int run = (int) BigNumber::borrowRun(result_loc, batchSize);
+    const bool propagate = run == batchSize;
+    Benchmark::lap(Benchmark::COMPUTE);
+
+    const BigNumber::Limb incoming = LookaheadCalculation::incomingCarry(generate, propagate, MPI_COMM_WORLD);
+    if (incoming) {
+        BigNumber::selectBorrow(result_loc, batchSize, run);
+    }
+    Benchmark::lap(Benchmark::CARRY);
+
+    MPI_Gatherv(result_loc, batchSize, MPI_LIMB, result, blockSize, blockStart, MPI_LIMB, 0, MPI_COMM_WORLD);
+    Benchmark::lap(Benchmark::GATHER);
+    if (rank == 0) {
+        ofstream outSub("resultSubtract.txt");
+        BigNumber::writeDigits(outSub, result, totalSize, N_Max);
+        if (order < 0) {
+            outSub << "-\n";
+        }
+        outSub.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+    }
+    BufferPool::release(firstNumber);
+    BufferPool::release(secondNumber);
+    BufferPool::release(first_loc);
+    BufferPool::release(second_loc);
+    BufferPool::release(result_loc);
+    BufferPool::release(blockStart);
+    BufferPool::release(blockSize);
+}
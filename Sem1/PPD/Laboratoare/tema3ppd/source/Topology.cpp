@@ -0,0 +1,143 @@
+#include "../header/Topology.h"
+#include <cstdlib>
+
+#include "../header/ScattervCalculation.h"
+#include "../header/BufferPool.h"
+
+using namespace std;
+
+Topology::Topology(MPI_Comm comm) {
+    int rank;
+    int P;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &P);
+    const char *simulated = getenv("TOPOLOGY_NODES");
+    const int simulatedNodes = simulated != nullptr ? atoi(simulated) : 0;
+    if (simulatedNodes > 0) {
+        MPI_Comm_split(comm, rank % simulatedNodes, rank, &node);
+    } else {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+    }
+    int nodeRank;
+    MPI_Comm_rank(node, &nodeRank);
+
+    // nodes numbered in the order of their first process, so the node of rank 0 comes first
+    MPI_Comm_split(comm, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &leaders);
+    nodeIndex = 0;
+    if (leaders != MPI_COMM_NULL) {
+        MPI_Comm_rank(leaders, &nodeIndex);
+    }
+    MPI_Bcast(&nodeIndex, 1, MPI_INT, 0, node);
+    // node by node, inside a node in the order of node: rank r of node is rank nodeFirst + r of blocks
+    MPI_Comm_split(comm, 0, nodeIndex * P + nodeRank, &blocks);
+
+    vector<int> indices(P);
+    MPI_Allgather(&nodeIndex, 1, MPI_INT, indices.data(), 1, MPI_INT, blocks);
+    for (int pid = 0; pid < P; pid++) {
+        if (indices[pid] == (int) nodeSize.size()) {
+            nodeFirst.push_back(pid);
+            nodeSize.push_back(0);
+        }
+        nodeSize[indices[pid]]++;
+    }
+}
+
+Topology::~Topology() {
+    MPI_Comm_free(&blocks);
+    MPI_Comm_free(&node);
+    if (leaders != MPI_COMM_NULL) {
+        MPI_Comm_free(&leaders);
+    }
+}
+
+void Topology::nodeRange(const int *blockStart, const int *blockSize, const int k, int &start, int &length) const {
+    start = blockStart[nodeFirst[k]];
+    length = 0;
+    for (int pid = nodeFirst[k]; pid < nodeFirst[k] + nodeSize[k]; pid++) {
+        length += blockSize[pid];
+    }
+}
+
+void Topology::scatterBlocks(const BigNumber::Limb *number, const int size, const int *blockStart,
+                             const int *blockSize, BigNumber::Limb *local) const {
+    if (nodes() == 1) {
+        ScattervCalculation::scatterBlocks(number, size, blockStart, blockSize, local, blocks);
+        return;
+    }
+    int rank;
+    MPI_Comm_rank(blocks, &rank);
+    const int first = nodeFirst[nodeIndex];
+    int start;
+    int length;
+    nodeRange(blockStart, blockSize, nodeIndex, start, length);
+
+    // process 0 sends every leader the part of the number covered by its node, as one message
+    BigNumber::Limb *nodeBlocks = nullptr;
+    if (leaders != MPI_COMM_NULL) {
+        int *nodeStart = BufferPool::acquire<int>(nodes());
+        int *nodeLength = BufferPool::acquire<int>(nodes());
+        int *counts = BufferPool::acquire<int>(nodes());
+        int *displacements = BufferPool::acquire<int>(nodes());
+        for (int k = 0; k < nodes(); k++) {
+            nodeRange(blockStart, blockSize, k, nodeStart[k], nodeLength[k]);
+        }
+        ScattervCalculation::operandLayout(nodeStart, nodeLength, nodes(), size, counts, displacements);
+        nodeBlocks = BufferPool::acquire<BigNumber::Limb>(length);
+        MPI_Scatterv(number, counts, displacements, MPI_LIMB, nodeBlocks, counts[nodeIndex], MPI_LIMB, 0, leaders);
+        for (int i = counts[nodeIndex]; i < length; i++) {
+            nodeBlocks[i] = 0;
+        }
+        BufferPool::release(nodeStart);
+        BufferPool::release(nodeLength);
+        BufferPool::release(counts);
+        BufferPool::release(displacements);
+    }
+
+    // leader-ul imparte blocurile nodului prin memoria partajata
+    int *displacements = BufferPool::acquire<int>(nodeSize[nodeIndex]);
+    for (int r = 0; r < nodeSize[nodeIndex]; r++) {
+        displacements[r] = blockStart[first + r] - start;
+    }
+    MPI_Scatterv(nodeBlocks, blockSize + first, displacements, MPI_LIMB, local, blockSize[rank], MPI_LIMB, 0, node);
+    BufferPool::release(displacements);
+    BufferPool::release(nodeBlocks);
+}
+
+void Topology::gatherBlocks(const BigNumber::Limb *local, const int *blockStart, const int *blockSize,
+                            BigNumber::Limb *result) const {
+    int rank;
+    MPI_Comm_rank(blocks, &rank);
+    if (nodes() == 1) {
+        MPI_Gatherv(local, blockSize[rank], MPI_LIMB, result, blockSize, blockStart, MPI_LIMB, 0, blocks);
+        return;
+    }
+    const int first = nodeFirst[nodeIndex];
+    int start;
+    int length;
+    nodeRange(blockStart, blockSize, nodeIndex, start, length);
+
+    // leader-ul aduna rezultatele nodului
+    BigNumber::Limb *nodeBlocks = nullptr;
+    if (leaders != MPI_COMM_NULL) {
+        nodeBlocks = BufferPool::acquire<BigNumber::Limb>(length);
+    }
+    int *displacements = BufferPool::acquire<int>(nodeSize[nodeIndex]);
+    for (int r = 0; r < nodeSize[nodeIndex]; r++) {
+        displacements[r] = blockStart[first + r] - start;
+    }
+    MPI_Gatherv(local, blockSize[rank], MPI_LIMB, nodeBlocks, blockSize + first, displacements, MPI_LIMB, 0, node);
+    BufferPool::release(displacements);
+
+    // one message per node to process 0
+    if (leaders != MPI_COMM_NULL) {
+        int *nodeStart = BufferPool::acquire<int>(nodes());
+        int *nodeLength = BufferPool::acquire<int>(nodes());
+        for (int k = 0; k < nodes(); k++) {
+            nodeRange(blockStart, blockSize, k, nodeStart[k], nodeLength[k]);
+        }
+        MPI_Gatherv(nodeBlocks, length, MPI_LIMB, result, nodeLength, nodeStart, MPI_LIMB, 0, leaders);
+        BufferPool::release(nodeStart);
+        BufferPool::release(nodeLength);
+        BufferPool::release(nodeBlocks);
+    }
+}
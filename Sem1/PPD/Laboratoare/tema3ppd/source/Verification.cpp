@@ -1,56 +1,147 @@
 #include "../header/Verification.h"
+#include "../header/GenerateNumber.h"
+#include "../header/Checksum.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <vector>
-#include <sstream>
-#include <algorithm>
 
 using namespace std;
 
-string normalizeContent(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        return "";
+namespace {
+    // digits compared per step, both files are streamed in chunks of this many bytes
+    const long long COMPARE_CHUNK = 1 << 20;
+
+    // Digit values of a binary number file or of a text file, one chunk at a time.
+    // Text characters other than whitespace become c - '0' (BigNumber::parseDigits), like the digits.
+    class DigitReader {
+    private:
+        ifstream in;
+        bool binary;
+        long long remaining;
+        vector<char> text;
+    public:
+        explicit DigitReader(const string &fileName)
+            : in(fileName, ios::binary), remaining(GenerateNumber::readNumberOfDigits(fileName)) {
+            binary = remaining >= 0;
+            if (binary) {
+                in.seekg(sizeof(NumberFileHeader));
+            } else {
+                text.resize(COMPARE_CHUNK);
+            }
+        }
+
+        bool isOpen() const {
+            return in.is_open();
+        }
+
+        // fills digits with at most COMPARE_CHUNK values, 0 at the end of the file
+        long long next(uint8_t *digits) {
+            if (binary) {
+                const long long count = min(remaining, COMPARE_CHUNK);
+                in.read(reinterpret_cast<char *>(digits), count);
+                remaining -= count;
+                return count;
+            }
+            long long count = 0;
+            while (count == 0 && in.read(text.data(), COMPARE_CHUNK).gcount() > 0) {
+                count = BigNumber::parseDigits(text.data(), in.gcount(), digits);
+            }
+            return count;
+        }
+    };
+}
+
+long long Verification::firstDifference(const string &file1, const string &file2) {
+    DigitReader first(file1);
+    DigitReader second(file2);
+    if (!first.isOpen() || !second.isOpen()) {
+        return UNREADABLE;
+    }
+    vector<uint8_t> firstDigits(COMPARE_CHUNK);
+    vector<uint8_t> secondDigits(COMPARE_CHUNK);
+    long long firstCount = 0, firstPosition = 0;
+    long long secondCount = 0, secondPosition = 0;
+    long long offset = 0;
+    while (true) {
+        if (firstPosition == firstCount) {
+            firstCount = first.next(firstDigits.data());
+            firstPosition = 0;
+        }
+        if (secondPosition == secondCount) {
+            secondCount = second.next(secondDigits.data());
+            secondPosition = 0;
+        }
+        if (firstCount == 0 || secondCount == 0) {
+            if (offset == 0) {
+                return UNREADABLE;
+            }
+            // equal only if both ended, otherwise the shorter one ends at offset
+            return firstCount == secondCount ? -1 : offset;
+        }
+        const long long length = min(firstCount - firstPosition, secondCount - secondPosition);
+        const uint8_t *a = firstDigits.data() + firstPosition;
+        const uint8_t *b = secondDigits.data() + secondPosition;
+        if (memcmp(a, b, length) != 0) {
+            return offset + (mismatch(a, a + length, b).first - a);
+        }
+        firstPosition += length;
+        secondPosition += length;
+        offset += length;
     }
-    
-    stringstream buffer;
-    buffer << file.rdbuf();
-    string content = buffer.str();
-    
-    // Remove all whitespace
-    content.erase(remove_if(content.begin(), content.end(), ::isspace), content.end());
-    
-    return content;
 }
 
 bool Verification::compareResults(const string& file1, const string& file2) {
-    string content1 = normalizeContent(file1);
-    string content2 = normalizeContent(file2);
-    
-    if (content1.empty() || content2.empty()) {
+    const long long difference = firstDifference(file1, file2);
+    if (difference == UNREADABLE) {
         cerr << "Error: Could not read files " << file1 << " or " << file2 << endl;
         return false;
     }
-    
-    return content1 == content2;
+    return difference < 0;
 }
 
 void Verification::printComparison(const string& variantName, const string& referenceFile, const string& testFile) {
-    bool match = compareResults(referenceFile, testFile);
-    
-    if (match) {
+    // checksum mode: the hashes written during the run are compared, the results are not read
+    uint64_t referenceHash;
+    uint64_t testHash;
+    if (Checksum::enabled) {
+        // every run drops the sidecars it rewrites, a missing one means no hash from this run
+        if (!Checksum::read(referenceFile, referenceHash) || !Checksum::read(testFile, testHash)) {
+            cerr << "Error: No checksum for " << referenceFile << " or " << testFile << endl;
+            cout << "[FAIL] " << variantName << " does NOT match sequential result! (checksum missing)" << endl;
+        } else if (referenceHash == testHash) {
+            cout << "[OK] " << variantName << " matches sequential result (checksum)" << endl;
+        } else {
+            cout << "[FAIL] " << variantName << " does NOT match sequential result! (checksum)" << endl;
+        }
+        return;
+    }
+
+    const long long difference = firstDifference(referenceFile, testFile);
+    if (difference == -1) {
         cout << "[OK] " << variantName << " matches sequential result" << endl;
-    } else {
+    } else if (difference == UNREADABLE) {
+        cerr << "Error: Could not read files " << referenceFile << " or " << testFile << endl;
         cout << "[FAIL] " << variantName << " does NOT match sequential result!" << endl;
+    } else {
+        cout << "[FAIL] " << variantName << " does NOT match sequential result! (first difference at digit "
+             << difference << ")" << endl;
     }
 }
 
 void Verification::runAllVerifications() {
     cout << "\n========== RESULT VERIFICATION ==========" << endl;
-    printComparison("Variant 1 (Standard)", "result.txt", "result1.txt");
-    printComparison("Variant 2 (Scatter)", "result.txt", "resultScatter.txt");
-    printComparison("Variant 3 (Async)", "result.txt", "resultAsync.txt");
-    printComparison("Variant 1.1 (Optimized)", "result.txt", "resultOptimized.txt");
+    printComparison("Variant 1 (Standard)", "result.bin", "result1.txt");
+    printComparison("Variant 2 (Scatter)", "result.bin", "resultScatter.txt");
+    printComparison("Variant 3 (Async)", "result.bin", "resultAsync.txt");
+    printComparison("Variant 1.1 (Optimized)", "result.bin", "resultOptimized.txt");
+    printComparison("Variant 4 (Carry-lookahead)", "result.bin", "resultLookahead.txt");
+    printComparison("Variant 5 (Parallel MPI-IO)", "result.bin", "resultParallelIO.txt");
+    printComparison("Variant 2.1 (Scatterv)", "result.bin", "resultScatterv.txt");
+    printComparison("Variant 6 (Hybrid)", "result.bin", "resultHybrid.txt");
+    printComparison("Variant 7 (RMA)", "result.bin", "resultRma.txt");
+    printComparison("Variant 8 (Non-blocking)", "result.bin", "resultNonblocking.txt");
+    printComparison("Variant 9 (Work queue)", "result.bin", "resultWorkQueue.txt");
     cout << "=========================================" << endl;
 }
-
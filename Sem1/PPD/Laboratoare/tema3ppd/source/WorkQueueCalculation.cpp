@@ -0,0 +1,221 @@
+#include "../header/WorkQueueCalculation.h"
+#include <mpi.h>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "../header/GenerateNumber.h"
+#include "../header/Benchmark.h"
+#include "../header/BufferPool.h"
+#include "../header/Checksum.h"
+
+using namespace std;
+
+namespace {
+    // a result chunk followed by its (carry out, all 9s) summary, received as one message:
+    // the chunk lands at its offset in the result, the summary in its own slot
+    MPI_Datatype chunkWithSummary(BigNumber::Limb *chunk, const int length, BigNumber::Limb *summary) {
+        MPI_Aint addresses[2];
+        MPI_Get_address(chunk, &addresses[0]);
+        MPI_Get_address(summary, &addresses[1]);
+        const int lengths[2] = {length, 2};
+        MPI_Datatype type;
+        MPI_Type_create_hindexed(2, lengths, addresses, MPI_LIMB, &type);
+        MPI_Type_commit(&type);
+        return type;
+    }
+}
+
+void WorkQueueCalculation::run() {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    calculator(rank);
+}
+
+// Tags: 1 chunk (both operands, the second right after the first), 2 no more chunks,
+// 3 result chunk followed by its carry out and whether it is all BASE - 1 limbs
+void WorkQueueCalculation::calculator(int rank) {
+    // the work is split in limbs of BigNumber::DIGITS_PER_LIMB digits, chunks of chunkSize limbs
+    const int totalSize = (int) BigNumber::limbCount(N_Max);
+    const int chunks = (totalSize + chunkSize - 1) / chunkSize;
+
+    if (rank == 0) {
+        // with no workers the master adds everything
+        const bool masterAdds = masterWorks || P == 1;
+        BigNumber::Limb *result = BufferPool::acquire<BigNumber::Limb>(totalSize);
+        BigNumber::Limb *summaries = BufferPool::acquire<BigNumber::Limb>(2 * chunks);
+        int *chunksDone = BufferPool::acquire<int>(P);
+        int *sent = BufferPool::acquire<int>(P);
+        const int slotSize = 2 * chunkSize;
+        BigNumber::Limb *operandSlots = BufferPool::acquire<BigNumber::Limb>((long long) P * PREFETCH * slotSize);
+        MPI_Request *sendRequests = BufferPool::acquire<MPI_Request>(P * PREFETCH);
+        for (int pid = 0; pid < P; pid++) {
+            chunksDone[pid] = 0;
+            sent[pid] = 0;
+        }
+        for (int i = 0; i < P * PREFETCH; i++) {
+            sendRequests[i] = MPI_REQUEST_NULL;
+        }
+        // chunks handed to every worker, in the order their results come back
+        vector<deque<int>> assigned(P);
+        int next = 0;
+        int pending = 0;
+
+        // the next chunk to pid, or a stop once the queue is empty
+        auto handOut = [&](const int pid) {
+            const int slot = sent[pid]++ % PREFETCH;
+            MPI_Request *request = &sendRequests[pid * PREFETCH + slot];
+            MPI_Wait(request, MPI_STATUS_IGNORE);
+            if (next == chunks) {
+                MPI_Send(nullptr, 0, MPI_LIMB, pid, 2, MPI_COMM_WORLD);
+                return;
+            }
+            const int c = next++;
+            const int offset = c * chunkSize;
+            const int length = min(chunkSize, totalSize - offset);
+            BigNumber::Limb *operands = operandSlots + (long long) (pid * PREFETCH + slot) * slotSize;
+            GenerateNumber::readNumberBlock("firstNumber.bin", offset, length, operands);
+            GenerateNumber::readNumberBlock("secondNumber.bin", offset, length, operands + length);
+            Benchmark::lap(Benchmark::READ);
+            MPI_Isend(operands, 2 * length, MPI_LIMB, pid, 1, MPI_COMM_WORLD, request);
+            Benchmark::lap(Benchmark::DISTRIBUTE);
+            assigned[pid].push_back(c);
+            pending++;
+        };
+
+        for (int pid = 1; pid < P; pid++) {
+            for (int k = 0; k < PREFETCH; k++) {
+                handOut(pid);
+            }
+        }
+        while (pending > 0 || (masterAdds && next < chunks)) {
+            int arrived = 0;
+            MPI_Status status;
+            if (pending > 0) {
+                if (masterAdds && next < chunks) {
+                    MPI_Iprobe(MPI_ANY_SOURCE, 3, MPI_COMM_WORLD, &arrived, &status);
+                } else {
+                    MPI_Probe(MPI_ANY_SOURCE, 3, MPI_COMM_WORLD, &status);
+                    arrived = 1;
+                }
+            }
+            if (!arrived) {
+                // nici un rezultat nu asteapta, master-ul aduna el urmatoarea bucata
+                const int c = next++;
+                const int offset = c * chunkSize;
+                const int length = min(chunkSize, totalSize - offset);
+                GenerateNumber::readNumberBlock("firstNumber.bin", offset, length, operandSlots);
+                GenerateNumber::readNumberBlock("secondNumber.bin", offset, length, operandSlots + length);
+                Benchmark::lap(Benchmark::READ);
+                summaries[2 * c] = BigNumber::sum(operandSlots, operandSlots + length, result + offset, length);
+                summaries[2 * c + 1] = BigNumber::carryRun(result + offset, length) == length;
+                chunksDone[0]++;
+                Benchmark::lap(Benchmark::COMPUTE);
+                continue;
+            }
+
+            // the result goes straight to its offset, whichever worker sent it
+            const int pid = status.MPI_SOURCE;
+            const int c = assigned[pid].front();
+            assigned[pid].pop_front();
+            pending--;
+            const int offset = c * chunkSize;
+            const int length = min(chunkSize, totalSize - offset);
+            MPI_Datatype chunk = chunkWithSummary(result + offset, length, summaries + 2 * c);
+            MPI_Recv(MPI_BOTTOM, 1, chunk, pid, 3, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            MPI_Type_free(&chunk);
+            chunksDone[pid]++;
+            Benchmark::lap(Benchmark::GATHER);
+            handOut(pid);
+        }
+        MPI_Waitall(P * PREFETCH, sendRequests, MPI_STATUSES_IGNORE);
+        Benchmark::lap(Benchmark::DISTRIBUTE);
+
+        // carry-ul care intra in fiecare bucata se stie din rezumatele celor de dinainte,
+        // apoi se aplica doar bucatilor care il primesc
+        BigNumber::Limb incoming = 0;
+        for (int c = 0; c < chunks; c++) {
+            const BigNumber::Limb carryOut = summaries[2 * c] | (summaries[2 * c + 1] & incoming);
+            if (incoming > 0) {
+                const int offset = c * chunkSize;
+                BigNumber::passCarry(result + offset, min(chunkSize, totalSize - offset), incoming);
+            }
+            incoming = carryOut;
+        }
+        Benchmark::lap(Benchmark::CARRY);
+
+        if (!Benchmark::measuring()) {
+            cout << "Chunks per process:";
+            for (int pid = 0; pid < P; pid++) {
+                cout << " " << pid << ":" << chunksDone[pid];
+            }
+            cout << endl;
+        }
+
+        ofstream outQ("resultWorkQueue.txt");
+        BigNumber::writeDigits(outQ, result, totalSize, N_Max);
+        if (Checksum::enabled) {
+            Checksum::write("resultWorkQueue.txt", Checksum::add(Checksum::hash(result, totalSize, 0),
+                                                                 Checksum::hash(&incoming, 1, totalSize)));
+        }
+        const BigNumber::Limb final_carry = BigNumber::overflowDigit(totalSize > 0 ? result[totalSize - 1] : 0,
+                                                                     N_Max, incoming);
+        if (final_carry > 0) {
+            outQ << final_carry << "\n";
+        }
+        outQ.close();
+        Benchmark::lap(Benchmark::WRITE);
+        BufferPool::release(result);
+        BufferPool::release(summaries);
+        BufferPool::release(chunksDone);
+        BufferPool::release(sent);
+        BufferPool::release(operandSlots);
+        BufferPool::release(sendRequests);
+    } else {
+        // PREFETCH receives stay posted, the next chunks arrive while this one is added
+        BigNumber::Limb *operands = BufferPool::acquire<BigNumber::Limb>(PREFETCH * 2 * chunkSize);
+        BigNumber::Limb *results = BufferPool::acquire<BigNumber::Limb>(PREFETCH * (chunkSize + 2));
+        MPI_Request recvRequests[PREFETCH];
+        MPI_Request resultRequests[PREFETCH];
+        for (int slot = 0; slot < PREFETCH; slot++) {
+            MPI_Irecv(operands + slot * 2 * chunkSize, 2 * chunkSize, MPI_LIMB, 0, MPI_ANY_TAG, MPI_COMM_WORLD,
+                      &recvRequests[slot]);
+            resultRequests[slot] = MPI_REQUEST_NULL;
+        }
+
+        for (int k = 0; ; k++) {
+            const int slot = k % PREFETCH;
+            MPI_Status status;
+            MPI_Wait(&recvRequests[slot], &status);
+            Benchmark::lap(Benchmark::DISTRIBUTE);
+            if (status.MPI_TAG == 2) {
+                // master-ul trimite cate un stop pentru fiecare receive inca deschis
+                for (int s = 1; s < PREFETCH; s++) {
+                    MPI_Wait(&recvRequests[(slot + s) % PREFETCH], MPI_STATUS_IGNORE);
+                }
+                break;
+            }
+            int count;
+            MPI_Get_count(&status, MPI_LIMB, &count);
+            const int length = count / 2;
+            BigNumber::Limb *first = operands + slot * 2 * chunkSize;
+            BigNumber::Limb *partial = results + slot * (chunkSize + 2);
+
+            MPI_Wait(&resultRequests[slot], MPI_STATUS_IGNORE);
+            partial[length] = BigNumber::sum(first, first + length, partial, length);
+            partial[length + 1] = BigNumber::carryRun(partial, length) == length;
+            Benchmark::lap(Benchmark::COMPUTE);
+
+            // worker trimite rezultatul cu rezumatul lui si cere urmatoarea bucata
+            MPI_Isend(partial, length + 2, MPI_LIMB, 0, 3, MPI_COMM_WORLD, &resultRequests[slot]);
+            MPI_Irecv(first, 2 * chunkSize, MPI_LIMB, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &recvRequests[slot]);
+            Benchmark::lap(Benchmark::GATHER);
+        }
+        MPI_Waitall(PREFETCH, resultRequests, MPI_STATUSES_IGNORE);
+        Benchmark::lap(Benchmark::GATHER);
+        BufferPool::release(operands);
+        BufferPool::release(results);
+    }
+}
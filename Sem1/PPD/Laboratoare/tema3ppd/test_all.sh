@@ -96,6 +96,63 @@ run_test 100 100000 8 "100 digits + 100000 digits, 8 processes"
 # Test 2.7
 run_test 100 100000 16 "100 digits + 100000 digits, 16 processes"
 
+echo ""
+echo "=== Test Set 3: Subtraction, Comparison, Multiplication, Reduction ==="
+echo ""
+
+# 14 sums the default operands (firstNumber.bin secondNumber.bin)
+for OPERATION in 11 12 13 14; do
+    echo "Operation $OPERATION: 10000 digits, 10000 digits, 5 processes"
+    OUTPUT=$(mpirun -np 5 ./build/Tema_3 10000 10000 $OPERATION)
+    STATUS=$?
+    echo "$OUTPUT"
+    if [ $STATUS -eq 0 ] && echo "$OUTPUT" | grep -q "\[OK\]" && ! echo "$OUTPUT" | grep -q "FAIL"; then
+        echo "✓ Operation $OPERATION matches the sequential result"
+    else
+        echo "✗ Operation $OPERATION failed"
+    fi
+    echo ""
+done
+
+echo "=== Test Set 4: Text to binary conversion ==="
+echo ""
+
+# input: file contents, expected digit count after a round trip (empty when the conversion must fail)
+convert_test() {
+    local CONTENTS=$1
+    local EXPECTED=$2
+    printf '%b' "$CONTENTS" > convertInput.txt
+    if [ -z "$EXPECTED" ]; then
+        if ./build/Tema_3 --to-binary convertInput.txt convertInput.bin 2> /dev/null; then
+            echo "✗ '$CONTENTS': accepted, should be rejected"
+        else
+            echo "✓ '$CONTENTS': rejected"
+        fi
+    elif ./build/Tema_3 --to-binary convertInput.txt convertInput.bin && \
+         ./build/Tema_3 --to-text convertInput.bin convertOutput.txt && \
+         [ "$(head -n 1 convertOutput.txt)" = "$EXPECTED" ]; then
+        echo "✓ '$CONTENTS': $EXPECTED digits"
+    else
+        echo "✗ '$CONTENTS': expected $EXPECTED digits"
+    fi
+    rm -f convertInput.txt convertInput.bin convertOutput.txt
+}
+
+convert_test "3\n1 2 3 " 3
+convert_test "1 2 3 \n" 3
+convert_test "abc\n1 2 3 " ""
+convert_test "12x\n1 2 3 " ""
+convert_test "99999999999999999999\n1 2 3 " ""
+convert_test "3\n1 2" ""
+convert_test "3\n1 2 a " ""
+if ./build/Tema_3 --to-binary missingInput.txt convertInput.bin 2> /dev/null; then
+    echo "✗ missing input: accepted, should be rejected"
+else
+    echo "✓ missing input: rejected"
+fi
+rm -f convertInput.bin
+echo ""
+
 echo "======================================"
 echo "All tests completed!"
 echo "======================================"
@@ -106,4 +163,12 @@ echo "  - result1.txt (Variant 1 - Standard)"
 echo "  - resultScatter.txt (Variant 2 - Scatter/Gather)"
 echo "  - resultAsync.txt (Variant 3 - Async)"
 echo "  - resultOptimized.txt (Variant 1.1 - Optimized)"
+echo "  - resultLookahead.txt (Variant 4 - Carry-lookahead)"
+echo "  - resultParallelIO.txt (Variant 5 - Parallel MPI-IO)"
+echo "  - resultScatterv.txt (Variant 2.1 - Scatterv/Gatherv)"
+echo "  - resultHybrid.txt (Variant 6 - Hybrid MPI + threads)"
+echo "  - resultRma.txt (Variant 7 - One-sided RMA carry)"
+echo "  - resultNonblocking.txt (Variant 8 - Non-blocking collectives)"
+echo "  - resultWorkQueue.txt (Variant 9 - Dynamic load balancing)"
+echo "  - resultSubtract.txt, resultCompare.txt, resultMultiply.txt (operations 11-13)"
 
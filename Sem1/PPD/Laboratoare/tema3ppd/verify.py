@@ -3,10 +3,19 @@
 Verification script to compare MPI results with sequential results
 """
 
+import struct
+
+BINARY_MAGIC = b"BNUM"
+
+
 def normalize_content(filename):
-    """Read file and normalize whitespace"""
-    with open(filename, 'r') as f:
-        content = f.read()
+    """Read file and normalize whitespace (binary number files are decoded)"""
+    with open(filename, 'rb') as f:
+        raw = f.read()
+    if raw[:4] == BINARY_MAGIC:
+        _, _, count = struct.unpack("<4sIQ", raw[:16])
+        return ''.join(chr(48 + d) for d in raw[16:16 + count])
+    content = raw.decode()
     # Remove all whitespace and compare just the digits
     return ''.join(content.split())
 
@@ -20,10 +29,17 @@ def main():
     print("\n========== RESULT VERIFICATION ==========")
     
     tests = [
-        ("Variant 1 (Standard)", "result.txt", "result1.txt"),
-        ("Variant 2 (Scatter)", "result.txt", "resultScatter.txt"),
-        ("Variant 3 (Async)", "result.txt", "resultAsync.txt"),
-        ("Variant 1.1 (Optimized)", "result.txt", "resultOptimized.txt"),
+        ("Variant 1 (Standard)", "result.bin", "result1.txt"),
+        ("Variant 2 (Scatter)", "result.bin", "resultScatter.txt"),
+        ("Variant 3 (Async)", "result.bin", "resultAsync.txt"),
+        ("Variant 1.1 (Optimized)", "result.bin", "resultOptimized.txt"),
+        ("Variant 4 (Carry-lookahead)", "result.bin", "resultLookahead.txt"),
+        ("Variant 5 (Parallel MPI-IO)", "result.bin", "resultParallelIO.txt"),
+        ("Variant 2.1 (Scatterv)", "result.bin", "resultScatterv.txt"),
+        ("Variant 6 (Hybrid)", "result.bin", "resultHybrid.txt"),
+        ("Variant 7 (RMA)", "result.bin", "resultRma.txt"),
+        ("Variant 8 (Non-blocking)", "result.bin", "resultNonblocking.txt"),
+        ("Variant 9 (Work queue)", "result.bin", "resultWorkQueue.txt"),
     ]
     
     for name, ref, test in tests: